@@ -0,0 +1,391 @@
+// -----------------------------------------------------------------------------
+// Benchmark de ponta a ponta do simulador (make bench).
+//
+// Gera cargas sintéticas de 10 a 100k processos em três perfis (CPU, E/S e
+// semáforos), executa cada cenário em modo headless num processo filho e
+// imprime um relatório JSON com eventos/s, razão tempo virtual/tempo real,
+// pico de memória (RSS) e tempo de CPU de cada subsistema.
+//
+// Cada cenário roda num fork próprio: o kernel e suas threads são únicos por
+// processo, e o pico de RSS medido pelo pai (wait4) fica isolado por cenário.
+//
+// Uso: ./icarus_bench [--sizes 10,1000,...] [--mixes cpu,io,sem]
+//                     [--timeout segundos] [--output arquivo.json] [opcoes do nucleo]
+// -----------------------------------------------------------------------------
+#include "../Interface/headless.h"
+#include "../Clock/timescale.h"
+#include "../Nucleo/thread_stats.h"
+#include "../Nucleo/config.h"
+#include "../Nucleo/metrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define DEFAULT_SCENARIO_TIMEOUT_S 60 // Limite de tempo real por cenário
+#define MAX_SIZES 16
+#define TEMPLATES_PER_MIX 8           // Variações de programa por perfil (PIDs se repetem entre elas)
+#define CHILD_REPORT_SIZE 1024
+
+static const int default_sizes[] = {10, 1000, 10000, 100000};
+
+// Perfis de carga
+typedef enum
+{
+    MIX_CPU, // Apenas exec: domina a CPU simulada e o escalonador
+    MIX_IO,  // Alterna exec com read/write/print: domina as filas de E/S
+    MIX_SEM, // Seções críticas P/V sobre poucos semáforos: domina a contenção
+    MIX_COUNT
+} WorkloadMix;
+
+static const char *mix_names[MIX_COUNT] = {"cpu", "io", "sem"};
+
+// -----------------------------------------------------------------------------
+// Geração das cargas de trabalho.
+// -----------------------------------------------------------------------------
+
+// Escreve o programa 'variant' de um perfil no formato .synt
+static int write_template(const char *path, WorkloadMix mix, int variant)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        return -1;
+
+    fprintf(file, "bench_%s_%d\n", mix_names[mix], variant);
+    fprintf(file, "%d\n", 100 + variant);    // Identificador do segmento
+    fprintf(file, "%d\n", 1 + variant % 5);  // Prioridade
+    fprintf(file, "%d\n", 16 + 8 * variant); // Tamanho do segmento (KB)
+
+    switch (mix)
+    {
+    case MIX_CPU:
+        fprintf(file, "\n");
+        for (int i = 0; i < 8; i++)
+            fprintf(file, "exec %d\n", 50 + 25 * ((variant + i) % 4));
+        break;
+    case MIX_IO:
+        fprintf(file, "\n");
+        for (int i = 0; i < 4; i++)
+        {
+            fprintf(file, "exec %d\n", 20 + 10 * variant);
+            fprintf(file, "%s %d\n", (i % 2 == 0) ? "read" : "write", 1 + (variant + i) % 16);
+        }
+        fprintf(file, "print %d\n", 10 + variant);
+        break;
+    case MIX_SEM:
+    default:
+    {
+        // Seções críticas não aninhadas: há contenção, mas nunca espera circular.
+        char first = 's', second = (variant % 2 == 0) ? 't' : 'u';
+        fprintf(file, "s t u\n");
+        for (int i = 0; i < 4; i++)
+        {
+            char name = (i % 2 == 0) ? first : second;
+            fprintf(file, "P(%c)\n", name);
+            fprintf(file, "exec %d\n", 20 + 5 * variant);
+            fprintf(file, "V(%c)\n", name);
+            fprintf(file, "exec 10\n");
+        }
+        break;
+    }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Execução de um cenário (processo filho).
+// -----------------------------------------------------------------------------
+
+// Roda o cenário e escreve o resultado parcial (sem RSS) em JSON no descritor 'report_fd'.
+static void run_scenario_child(const char *workload_dir, WorkloadMix mix, int process_count,
+                               int timeout_s, int report_fd)
+{
+    alarm(timeout_s); // O pai reconhece o SIGALRM como estouro de tempo
+
+    char **paths = malloc(sizeof(char *) * process_count);
+    for (int i = 0; i < process_count; i++)
+    {
+        paths[i] = malloc(strlen(workload_dir) + 32);
+        sprintf(paths[i], "%s/%s_%d.synt", workload_dir, mix_names[mix], i % TEMPLATES_PER_MIX);
+    }
+
+    Timescale__configure("afap");
+    HeadlessReport report;
+    Headless__simulate(paths, NULL, process_count, &report);
+    free(paths);
+
+    char buffer[CHILD_REPORT_SIZE];
+    int length = snprintf(buffer, sizeof(buffer),
+                          "\"status\": \"%s\", \"terminated\": %d, \"events\": %lld, "
+                          "\"wall_seconds\": %.6f, \"events_per_sec\": %.0f, "
+                          "\"virtual_time\": %lld, \"sim_wall_ratio\": %.1f, \"context_switches\": %lld, "
+                          "\"core_steals\": %lld, \"subsystems_cpu_seconds\": {",
+                          report.terminated_count == process_count ? "ok"
+                          : report.failed_count > 0                ? "load_error"
+                                                                   : "stalled",
+                          report.terminated_count, report.dispatched_events, report.wall_seconds,
+                          report.wall_seconds > 0 ? report.dispatched_events / report.wall_seconds : 0.0,
+                          report.virtual_time,
+                          report.wall_seconds > 0 ? report.virtual_time / report.wall_seconds : 0.0,
+                          report.context_switches, report.steal_count);
+    for (int subsystem = 0; subsystem < SUBSYSTEM_COUNT; subsystem++)
+    {
+        length += snprintf(buffer + length, sizeof(buffer) - length, "\"%s\": %.6f, ",
+                           ThreadStats__get_subsystem_name((Subsystem)subsystem),
+                           ThreadStats__get_cpu_seconds((Subsystem)subsystem));
+    }
+    // Remove a vírgula final e acrescenta o tempo real gasto no escalonador e as métricas de escalonamento
+    SystemMetrics metrics;
+    Metrics__get_system(&metrics);
+    snprintf(buffer + length - 2, sizeof(buffer) - length + 2,
+             "}, \"scheduler_wall_seconds\": %.6f, \"cpu_utilization\": %.4f, \"throughput_per_1000\": %.4f, "
+             "\"turnaround_p50\": %lld, \"turnaround_p99\": %lld, \"response_p99\": %lld, \"ready_wait_p99\": %lld",
+             report.scheduler_seconds, metrics.cpu_utilization, metrics.throughput, metrics.turnaround.p50,
+             metrics.turnaround.p99, metrics.response.p99, metrics.ready_wait.p99);
+
+    if (write(report_fd, buffer, strlen(buffer)) < 0)
+        _exit(1);
+    // As threads do simulador continuam vivas: encerra sem esperar por elas.
+    _exit(0);
+}
+
+// -----------------------------------------------------------------------------
+// Execução de um cenário (processo pai).
+// -----------------------------------------------------------------------------
+static void run_scenario(FILE *output, const char *workload_dir, WorkloadMix mix, int process_count,
+                         int timeout_s, int is_first)
+{
+    fprintf(stderr, "==> Cenario %s/%d...\n", mix_names[mix], process_count);
+    fflush(output);
+
+    int report_pipe[2];
+    if (pipe(report_pipe) != 0)
+    {
+        perror("bench: pipe");
+        return;
+    }
+
+    pid_t child = fork();
+    if (child < 0)
+    {
+        perror("bench: fork");
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+        return;
+    }
+    if (child == 0)
+    {
+        close(report_pipe[0]);
+        run_scenario_child(workload_dir, mix, process_count, timeout_s, report_pipe[1]);
+    }
+    close(report_pipe[1]);
+
+    // Lê o relatório antes de esperar o filho, para não travar num pipe cheio
+    char report[CHILD_REPORT_SIZE];
+    size_t report_length = 0;
+    ssize_t chunk;
+    while (report_length < sizeof(report) - 1 &&
+           (chunk = read(report_pipe[0], report + report_length, sizeof(report) - 1 - report_length)) > 0)
+    {
+        report_length += (size_t)chunk;
+    }
+    report[report_length] = '\0';
+    close(report_pipe[0]);
+
+    int status;
+    struct rusage usage;
+    wait4(child, &status, 0, &usage);
+
+    fprintf(output, "%s    {\"name\": \"%s_%d\", \"mix\": \"%s\", \"processes\": %d, \"sched\": \"%s\", \"cores\": %d, ",
+            is_first ? "" : ",\n", mix_names[mix], process_count, mix_names[mix], process_count,
+            kernel_config.sched_policy, kernel_config.cpu_core_count);
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && report_length > 0)
+    {
+        fprintf(output, "%s, ", report);
+    }
+    else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM)
+    {
+        fprintf(output, "\"status\": \"timeout\", ");
+    }
+    else
+    {
+        fprintf(output, "\"status\": \"failed\", ");
+    }
+    fprintf(output, "\"peak_rss_kb\": %ld}", usage.ru_maxrss);
+    fflush(output);
+}
+
+// -----------------------------------------------------------------------------
+// Leitura das opções.
+// -----------------------------------------------------------------------------
+
+// Lê uma lista separada por vírgulas de tamanhos. Retorna a quantidade lida, ou -1.
+static int parse_sizes(const char *text, int *sizes)
+{
+    int count = 0;
+    const char *cursor = text;
+    while (*cursor != '\0' && count < MAX_SIZES)
+    {
+        char *end;
+        long value = strtol(cursor, &end, 10);
+        if (end == cursor || value <= 0 || (*end != ',' && *end != '\0'))
+            return -1;
+        sizes[count++] = (int)value;
+        cursor = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+// Lê uma lista separada por vírgulas de perfis. Retorna 0, ou -1 se algum for desconhecido.
+static int parse_mixes(const char *text, int *enabled)
+{
+    char *copy = strdup(text);
+    char *save = NULL;
+    memset(enabled, 0, sizeof(int) * MIX_COUNT);
+    for (char *token = strtok_r(copy, ",", &save); token != NULL; token = strtok_r(NULL, ",", &save))
+    {
+        int found = 0;
+        for (int mix = 0; mix < MIX_COUNT; mix++)
+        {
+            if (strcmp(token, mix_names[mix]) == 0)
+            {
+                enabled[mix] = found = 1;
+            }
+        }
+        if (!found)
+        {
+            free(copy);
+            return -1;
+        }
+    }
+    free(copy);
+    return 0;
+}
+
+static void print_usage()
+{
+    fprintf(stderr, "Uso: icarus_bench [opcoes]\n");
+    fprintf(stderr, "  --sizes N,N,...     Quantidades de processos (padrao: 10,1000,10000,100000)\n");
+    fprintf(stderr, "  --mixes cpu,io,sem  Perfis de carga a executar (padrao: todos)\n");
+    fprintf(stderr, "  --timeout S         Limite de tempo real por cenario, em segundos (padrao: %d)\n",
+            DEFAULT_SCENARIO_TIMEOUT_S);
+    fprintf(stderr, "  --output arquivo    Grava o JSON no arquivo em vez da saida padrao\n");
+    fprintf(stderr, "Opcoes do nucleo (ex: --sched cfs), aplicadas a todos os cenarios:\n");
+    Config__print_usage(stderr);
+}
+
+int main(int argc, char *argv[])
+{
+    int sizes[MAX_SIZES];
+    int size_count = sizeof(default_sizes) / sizeof(default_sizes[0]);
+    memcpy(sizes, default_sizes, sizeof(default_sizes));
+    int mix_enabled[MIX_COUNT] = {1, 1, 1};
+    int timeout_s = DEFAULT_SCENARIO_TIMEOUT_S;
+    const char *output_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        int has_value = (i + 1 < argc);
+        if (strcmp(argv[i], "--sizes") == 0 && has_value)
+        {
+            size_count = parse_sizes(argv[++i], sizes);
+            if (size_count <= 0)
+            {
+                print_usage();
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--mixes") == 0 && has_value)
+        {
+            if (parse_mixes(argv[++i], mix_enabled) != 0)
+            {
+                print_usage();
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--timeout") == 0 && has_value)
+        {
+            timeout_s = atoi(argv[++i]);
+            if (timeout_s <= 0)
+            {
+                print_usage();
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--output") == 0 && has_value)
+        {
+            output_path = argv[++i];
+        }
+        else if (Config__parse_option(argc, argv, &i) > 0)
+        {
+            // Opção do núcleo (ex: --sched), herdada pelos cenários
+        }
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    FILE *output = stdout;
+    if (output_path != NULL && (output = fopen(output_path, "w")) == NULL)
+    {
+        perror("bench: output");
+        return 1;
+    }
+
+    // Os programas de cada perfil ficam num diretório temporário, repetidos entre os PIDs.
+    char workload_dir[] = "/tmp/icarus_bench_XXXXXX";
+    if (mkdtemp(workload_dir) == NULL)
+    {
+        perror("bench: mkdtemp");
+        return 1;
+    }
+    char template_path[sizeof(workload_dir) + 32];
+    for (int mix = 0; mix < MIX_COUNT; mix++)
+    {
+        for (int variant = 0; variant < TEMPLATES_PER_MIX; variant++)
+        {
+            sprintf(template_path, "%s/%s_%d.synt", workload_dir, mix_names[mix], variant);
+            if (write_template(template_path, (WorkloadMix)mix, variant) != 0)
+            {
+                perror("bench: workload");
+                return 1;
+            }
+        }
+    }
+
+    fprintf(output, "{\n  \"timeout_seconds\": %d,\n  \"benchmarks\": [\n", timeout_s);
+    int is_first = 1;
+    for (int mix = 0; mix < MIX_COUNT; mix++)
+    {
+        if (!mix_enabled[mix])
+            continue;
+        for (int i = 0; i < size_count; i++)
+        {
+            run_scenario(output, workload_dir, (WorkloadMix)mix, sizes[i], timeout_s, is_first);
+            is_first = 0;
+        }
+    }
+    fprintf(output, "\n  ]\n}\n");
+
+    // Remove os programas gerados
+    for (int mix = 0; mix < MIX_COUNT; mix++)
+    {
+        for (int variant = 0; variant < TEMPLATES_PER_MIX; variant++)
+        {
+            sprintf(template_path, "%s/%s_%d.synt", workload_dir, mix_names[mix], variant);
+            unlink(template_path);
+        }
+    }
+    rmdir(workload_dir);
+
+    if (output != stdout)
+        fclose(output);
+    return 0;
+}
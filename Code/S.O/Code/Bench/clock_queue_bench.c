@@ -0,0 +1,122 @@
+// -----------------------------------------------------------------------------
+// Microbenchmark da fila de eventos futuros do clock.
+//
+// Compara a lista ordenada (add_to_list_sorted, implementação anterior) com o
+// heap d-ário (Ferramentas/heap.c) usando o modelo "hold": a fila é preenchida
+// com N eventos pendentes e, em seguida, cada operação retira o evento mais
+// próximo e agenda um novo no futuro, mantendo o tamanho constante.
+//
+// Uso: ./clock_queue_bench [operacoes_por_tamanho]
+// -----------------------------------------------------------------------------
+#include "../Ferramentas/list.h"
+#include "../Ferramentas/heap.h"
+#include "../Nucleo/events.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_HOLD_OPERATIONS 20000
+#define MAX_EVENT_DELAY 10000
+
+static double now_seconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Gera o mesmo vetor de atrasos pseudoaleatórios para as duas implementações.
+static long long *generate_delays(int count, unsigned int seed)
+{
+    long long *delays = malloc(sizeof(long long) * count);
+    srand(seed);
+    for (int i = 0; i < count; i++)
+    {
+        delays[i] = 1 + rand() % MAX_EVENT_DELAY;
+    }
+    return delays;
+}
+
+// Executa o modelo hold sobre a lista ordenada. Retorna o custo médio (ns) por operação.
+static double bench_sorted_list(int pending_count, int hold_operations, long long *delays)
+{
+    List *queue = create_list();
+    KernelEvent *events = calloc(pending_count, sizeof(KernelEvent));
+    unsigned long long sequence = 0;
+
+    // Preenche em ordem decrescente: cada inserção cai na cabeça da lista (O(1)),
+    // para que o custo do preenchimento não domine a medição.
+    for (int i = 0; i < pending_count; i++)
+    {
+        events[i].execution_time = pending_count - i;
+        events[i].sequence = sequence++;
+        add_to_list_sorted(queue, &events[i], compare_event_time);
+    }
+
+    double start = now_seconds();
+    for (int op = 0; op < hold_operations; op++)
+    {
+        KernelEvent *next_event = (KernelEvent *)remove_first_from_list(queue);
+        next_event->execution_time += delays[op];
+        next_event->sequence = sequence++;
+        add_to_list_sorted(queue, next_event, compare_event_time);
+    }
+    double elapsed = now_seconds() - start;
+
+    destroy_list(queue);
+    free(events);
+    return elapsed * 1e9 / hold_operations;
+}
+
+// Executa o modelo hold sobre o heap. Retorna o custo médio (ns) por operação.
+static double bench_heap(int pending_count, int hold_operations, long long *delays)
+{
+    Heap *queue = create_heap(compare_event_time);
+    KernelEvent *events = calloc(pending_count, sizeof(KernelEvent));
+    unsigned long long sequence = 0;
+
+    for (int i = 0; i < pending_count; i++)
+    {
+        events[i].execution_time = pending_count - i;
+        events[i].sequence = sequence++;
+        heap_push(queue, &events[i]);
+    }
+
+    double start = now_seconds();
+    for (int op = 0; op < hold_operations; op++)
+    {
+        KernelEvent *next_event = (KernelEvent *)heap_pop(queue);
+        next_event->execution_time += delays[op];
+        next_event->sequence = sequence++;
+        heap_push(queue, next_event);
+    }
+    double elapsed = now_seconds() - start;
+
+    destroy_heap(queue);
+    free(events);
+    return elapsed * 1e9 / hold_operations;
+}
+
+int main(int argc, char *argv[])
+{
+    int hold_operations = argc > 1 ? atoi(argv[1]) : DEFAULT_HOLD_OPERATIONS;
+    if (hold_operations <= 0)
+    {
+        fprintf(stderr, "Uso: %s [operacoes_por_tamanho]\n", argv[0]);
+        return 1;
+    }
+
+    const int pending_sizes[] = {1000, 10000, 100000};
+    long long *delays = generate_delays(hold_operations, 42);
+
+    printf("%-10s %18s %18s %10s\n", "pendentes", "lista (ns/op)", "heap (ns/op)", "ganho");
+    for (int i = 0; i < (int)(sizeof(pending_sizes) / sizeof(pending_sizes[0])); i++)
+    {
+        double list_ns = bench_sorted_list(pending_sizes[i], hold_operations, delays);
+        double heap_ns = bench_heap(pending_sizes[i], hold_operations, delays);
+        printf("%-10d %18.1f %18.1f %9.1fx\n", pending_sizes[i], list_ns, heap_ns, list_ns / heap_ns);
+    }
+
+    free(delays);
+    return 0;
+}
@@ -1,77 +1,205 @@
 #include "cpu.h"
 #include "../Nucleo/kernel.h"
+#include "../Nucleo/config.h"
+#include "../Clock/clock.h"
+#include "../Clock/timescale.h"
+#include "../Nucleo/thread_stats.h"
 #include <pthread.h>
-#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
 
-// Estado da CPU
-static Bcp *current_process = NULL;
-static int is_busy = 0; // 1 se a CPU está "ocupada" com uma instrução de tempo (exec)
+// Estado de um núcleo da CPU (protegido por cpu_mutex)
+typedef struct
+{
+    Bcp *current_process;
+    int is_busy;               // 1 se o núcleo está "ocupado" com uma instrução de tempo (exec) ou aguardando o kernel
+    int has_pending_work;      // 1 se há um processo no núcleo com instruções a executar agora
+    int executing_instruction; // 1 enquanto a thread do núcleo executa uma instrução
+    pthread_cond_t cond;       // Acorda a thread do núcleo
+} CpuCore;
+
+static CpuCore *cores = NULL;
+static int core_count = 0;
 
 // Sincronização
+// O mutex é único para todos os núcleos e recursivo: a thread de um núcleo o mantém
+// durante a execução de uma instrução, e a própria instrução pode chamar CPU__set_busy.
 static pthread_mutex_t cpu_mutex;
-static pthread_cond_t cpu_cond;
 
-// Thread principal da CPU, que executa instruções em loop
+// Informa ao clock quando o núcleo passa a ter (ou deixa de ter) instruções a executar
+// no instante atual. Deve ser chamada com o mutex da CPU travado.
+// Durante uma instrução a atualização é adiada até o fim dela: a instrução marca o
+// núcleo como ocupado antes de despachar seu evento, e o clock não pode considerar o
+// instante concluído nesse intervalo.
+static void update_pending_work(CpuCore *core)
+{
+    if (core->executing_instruction)
+        return;
+    int has_work = (core->current_process != NULL && !core->is_busy);
+    if (has_work == core->has_pending_work)
+        return;
+    core->has_pending_work = has_work;
+    if (has_work)
+        Clock__begin_activity();
+    else
+        Clock__end_activity(); // Acorda os núcleos que esperavam a vez (ver is_core_turn)
+}
+
+// No modo determinístico com mais de um núcleo, um núcleo com instruções a executar só
+// executa a próxima quando nenhum núcleo de índice menor tem instruções a executar e o
+// único trabalho em andamento no clock é o dos próprios núcleos (nenhum evento ou pedido
+// de E/S em tratamento). Deve ser chamada com o mutex da CPU travado.
+static int is_core_turn(const CpuCore *core)
+{
+    if (!kernel_config.deterministic || core_count == 1)
+        return 1;
+    int cores_with_work = 0;
+    for (int i = 0; i < core_count; i++)
+    {
+        if (!cores[i].has_pending_work)
+            continue;
+        if (&cores[i] < core)
+            return 0;
+        cores_with_work++;
+    }
+    return Clock__get_pending_activity() == cores_with_work;
+}
+
+// Acorda as threads de todos os núcleos. Deve ser chamada com o mutex da CPU travado.
+static void wake_all_cores()
+{
+    for (int i = 0; i < core_count; i++)
+        pthread_cond_signal(&cores[i].cond);
+}
+
+// Thread de um núcleo, que executa instruções em loop
 void *cpu_thread_runner(void *args)
 {
+    CpuCore *core = (CpuCore *)args;
+    ThreadStats__register_current(SUBSYSTEM_CPU);
     while (1)
     {
         pthread_mutex_lock(&cpu_mutex);
-        // Se não há processo ou a CPU está ocupada (em um 'exec' longo), a thread dorme
-        while (current_process == NULL || is_busy)
+        // Se não há processo, o núcleo está ocupado (em um 'exec' longo) ou não é a sua vez
+        // (ver is_core_turn), a thread dorme
+        while (core->current_process == NULL || core->is_busy || !is_core_turn(core))
         {
-            pthread_cond_wait(&cpu_cond, &cpu_mutex);
+            pthread_cond_wait(&core->cond, &cpu_mutex);
         }
-        pthread_mutex_unlock(&cpu_mutex);
 
         // Se acordou e há um processo válido e no estado de execução...
-        if (current_process != NULL && current_process->current_execution_state == PROCESS_STATE_RUNNING)
+        // A instrução roda com o mutex travado, para que uma troca de contexto
+        // não aconteça no meio dela.
+        if (Process__get_state(core->current_process) == PROCESS_STATE_RUNNING)
         {
             // ... executa UMA instrução do processo
-            execute_current_process_instruction(current_process);
+            core->executing_instruction = 1;
+            execute_current_process_instruction(core->current_process);
+            core->executing_instruction = 0;
+            update_pending_work(core);
         }
+        pthread_mutex_unlock(&cpu_mutex);
 
-        // Pequena pausa para não sobrecarregar o processador do computador real
-        // e permitir que outras threads (como a da UI) rodem.
-        usleep(200000); // 0.2 segundos para melhor visualização
+        // Pausa entre instruções definida pela escala de tempo (ex: 0.2 s no modo
+        // step padrão da interface, nenhuma no modo afap).
+        Timescale__pace_instruction();
     }
     return NULL;
 }
 
 void CPU__initialize()
 {
-    pthread_mutex_init(&cpu_mutex, NULL);
-    pthread_cond_init(&cpu_cond, NULL);
-    pthread_t cpu_tid;
-    pthread_create(&cpu_tid, NULL, cpu_thread_runner, NULL);
-    pthread_detach(cpu_tid);
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cpu_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    core_count = kernel_config.cpu_core_count;
+    cores = calloc((size_t)core_count, sizeof(CpuCore));
+    if (cores == NULL)
+    {
+        fprintf(stderr, "Erro: memoria insuficiente para os nucleos da CPU\n");
+        exit(1);
+    }
+    for (int i = 0; i < core_count; i++)
+    {
+        pthread_cond_init(&cores[i].cond, NULL);
+        pthread_t cpu_tid;
+        pthread_create(&cpu_tid, NULL, cpu_thread_runner, &cores[i]);
+        pthread_detach(cpu_tid);
+    }
+}
+
+int CPU__get_core_count()
+{
+    return core_count;
+}
+
+void CPU__notify_activity_finished()
+{
+    if (!kernel_config.deterministic || core_count <= 1)
+        return;
+    pthread_mutex_lock(&cpu_mutex);
+    wake_all_cores();
+    pthread_mutex_unlock(&cpu_mutex);
+}
+
+// Trava a CPU, impedindo que uma instrução seja executada durante a seção crítica
+void CPU__lock()
+{
+    pthread_mutex_lock(&cpu_mutex);
+}
+
+// Destrava a CPU
+void CPU__unlock()
+{
+    pthread_mutex_unlock(&cpu_mutex);
 }
 
-// Define qual processo a CPU deve executar (ou NULL para ociosa)
-void CPU__run_process(Bcp *process)
+// Define qual processo o núcleo deve executar (ou NULL para ocioso)
+void CPU__run_process(int core_id, Bcp *process)
 {
     pthread_mutex_lock(&cpu_mutex);
-    current_process = process;
-    is_busy = 0; // Por padrão, a CPU não está ocupada
+    CpuCore *core = &cores[core_id];
+    core->current_process = process;
+    core->is_busy = 0; // Por padrão, o núcleo não está ocupado
+    update_pending_work(core);
 
-    // Acorda a thread da CPU se houver um processo para rodar
+    // Acorda a thread do núcleo se houver um processo para rodar
     if (process != NULL)
     {
-        pthread_cond_signal(&cpu_cond);
+        pthread_cond_signal(&core->cond);
     }
     pthread_mutex_unlock(&cpu_mutex);
 }
 
-// Usado pela instrução 'exec' para travar a CPU por um tempo
-void CPU__set_busy(int busy_status)
+// Retorna se o núcleo está ocupado (1) ou livre (0)
+int CPU__is_busy(int core_id)
 {
     pthread_mutex_lock(&cpu_mutex);
-    is_busy = busy_status;
+    int busy = cores[core_id].is_busy;
+    pthread_mutex_unlock(&cpu_mutex);
+    return busy;
+}
 
-    // Se a CPU deixou de estar ocupada, acorda a thread para continuar
-    if (!is_busy)
+// Usado pelas instruções para travar o núcleo até que o kernel conclua o evento gerado.
+// Só tem efeito se 'process' ainda for o processo no seu núcleo, evitando que um evento
+// atrasado de um processo afete outro.
+void CPU__set_busy(Bcp *process, int busy_status)
+{
+    pthread_mutex_lock(&cpu_mutex);
+    CpuCore *core = &cores[process->cpu_core];
+    if (core->current_process == process)
     {
-        pthread_cond_signal(&cpu_cond);
+        core->is_busy = busy_status;
+        update_pending_work(core);
+
+        // Se o núcleo deixou de estar ocupado, acorda a thread para continuar
+        if (!core->is_busy)
+        {
+            pthread_cond_signal(&core->cond);
+        }
     }
     pthread_mutex_unlock(&cpu_mutex);
-}
\ No newline at end of file
+}
@@ -3,16 +3,42 @@
 
 #include "../Process/process.h"
 
-// Inicializa a CPU (configurações iniciais, se necessário)
+// -----------------------------------------------------------------------------
+// A CPU tem kernel_config.cpu_core_count núcleos, cada um com sua thread e seu
+// processo em execução. As instruções de todos os núcleos executam sob a mesma
+// trava (CPU__lock), então as trocas de contexto continuam atômicas em relação a
+// qualquer núcleo; o paralelismo é o do tempo virtual: rajadas de 'exec' de
+// núcleos diferentes correm ao mesmo tempo no relógio da simulação.
+//
+// No modo determinístico, os núcleos com instruções a executar no mesmo instante
+// se revezam em ordem de índice, e um núcleo só executa uma instrução depois que o
+// kernel terminou de tratar tudo o que a instrução anterior (de qualquer núcleo)
+// gerou. Assim a ordem das instruções, e dos eventos que elas despacham, não
+// depende de qual thread ganha a trava da CPU.
+// -----------------------------------------------------------------------------
+
+// Inicializa a CPU, criando uma thread por núcleo
 void CPU__initialize();
 
-// Executa um processo na CPU
-void CPU__run_process(Bcp *process);
+// Retorna a quantidade de núcleos
+int CPU__get_core_count();
+
+// Executa um processo no núcleo indicado (NULL deixa o núcleo ocioso)
+void CPU__run_process(int core, Bcp *process);
+
+// Retorna se o núcleo está ocupado (1) ou livre (0)
+int CPU__is_busy(int core);
+
+// Define o status de ocupação do núcleo em que o processo executa (1 para ocupado, 0 para livre).
+// Ignorado se 'process' não for o processo atualmente nesse núcleo.
+void CPU__set_busy(Bcp *process, int busy_status);
 
-// Retorna se a CPU está ocupada (1) ou livre (0)
-int CPU__is_busy();
+// Chamada pelo clock quando um trabalho do instante atual termina: no modo determinístico
+// com mais de um núcleo, acorda os núcleos para que reavaliem de quem é a vez.
+void CPU__notify_activity_finished();
 
-// Define o status de ocupação da CPU (1 para ocupada, 0 para livre)
-void CPU__set_busy(int busy_status);
+// Trava/destrava a CPU (todos os núcleos) para que nenhuma instrução execute durante uma troca de contexto
+void CPU__lock();
+void CPU__unlock();
 
-#endif
\ No newline at end of file
+#endif
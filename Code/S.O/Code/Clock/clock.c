@@ -1,14 +1,25 @@
 #include "clock.h"
-#include "../Ferramentas/list.h"
+#include "../Ferramentas/heap.h"
 #include "../Nucleo/kernel.h"
+#include "../Nucleo/config.h"
+#include "timescale.h"
+#include "../Nucleo/thread_stats.h"
+#include "../CPU/cpu.h"
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h> 
 
 // Variável que armazena o tempo virtual da simulação
 static long long virtual_clock_time = 0;
-// Fila de eventos futuros (lista encadeada)
-static List *future_events_queue;
+// Fila de eventos futuros: heap de mínimo ordenado por (tempo de execução, sequência)
+static Heap *future_events_queue;
+// Contador usado para desempatar eventos agendados para o mesmo instante (FIFO)
+static unsigned long long next_event_sequence = 0;
+// Trabalhos em andamento no instante atual (usado apenas no modo determinístico)
+static int pending_activity_count = 0;
+
+// Máximo de eventos do mesmo instante despachados em um único lote
+#define CLOCK_DISPATCH_BATCH 64
 
 // Sincronização para a fila de eventos futuros
 static pthread_mutex_t clock_mutex; // Mutex para proteger acesso à fila
@@ -17,33 +28,65 @@ static pthread_cond_t clock_cond;   // Variável de condição para sinalizar no
 // Thread principal que processa o tempo e os eventos futuros
 void *clock_thread_runner(void *args)
 {
+    ThreadStats__register_current(SUBSYSTEM_CLOCK);
     while (1)
     {
         pthread_mutex_lock(&clock_mutex); // Garante acesso exclusivo à fila
 
-        // Espera até que haja pelo menos um evento na fila
-        while (future_events_queue->size == 0)
+        // Espera até que haja pelo menos um evento na fila. No modo determinístico,
+        // espera também que todo o trabalho do instante atual termine: só então o
+        // tempo pode saltar diretamente para o próximo evento.
+        while (future_events_queue->size == 0 ||
+               (kernel_config.deterministic && __atomic_load_n(&pending_activity_count, __ATOMIC_ACQUIRE) > 0))
         {
             pthread_cond_wait(&clock_cond, &clock_mutex);
         }
 
-        // Pega o primeiro evento da fila
-        Node *event_node = future_events_queue->head;
-        KernelEvent *next_event = (KernelEvent *)event_node->data;
+        // No modo ratio, o evento só é liberado quando o tempo real alcança seu instante virtual.
+        // A espera é interrompida por novos eventos (que podem ser mais próximos) e por
+        // mudanças de velocidade; em ambos os casos o laço reavalia a cabeça da fila.
+        KernelEvent *head_event = (KernelEvent *)heap_peek(future_events_queue);
+        struct timespec release_deadline;
+        if (Timescale__get_event_deadline(head_event->execution_time, virtual_clock_time, &release_deadline))
+        {
+            pthread_cond_timedwait(&clock_cond, &clock_mutex, &release_deadline);
+            pthread_mutex_unlock(&clock_mutex);
+            continue;
+        }
 
-        // Atualiza o tempo virtual para o tempo do próximo evento, se necessário
-        if (next_event->execution_time > virtual_clock_time)
+        // Remove o evento mais próximo da fila e, fora do modo determinístico (que libera
+        // um evento por vez), também os demais eventos do mesmo instante.
+        KernelEvent *released_events[CLOCK_DISPATCH_BATCH];
+        EventDispatch batch[CLOCK_DISPATCH_BATCH];
+        int batch_size = 0;
+        long long release_time = head_event->execution_time;
+        int batch_limit = kernel_config.deterministic ? 1 : CLOCK_DISPATCH_BATCH;
+        while (batch_size < batch_limit && future_events_queue->size > 0 &&
+               ((KernelEvent *)heap_peek(future_events_queue))->execution_time == release_time)
         {
-            virtual_clock_time = next_event->execution_time;
+            KernelEvent *next_event = (KernelEvent *)heap_pop(future_events_queue);
+            released_events[batch_size] = next_event;
+            batch[batch_size].type = next_event->type;
+            batch[batch_size].data = next_event->data;
+            batch_size++;
         }
 
-        // Remove o evento da fila e o despacha para o kernel
-        remove_from_list(future_events_queue, next_event, compare_event);
-        Kernel__dispatch_event(next_event->type, next_event->data);
+        // Atualiza o tempo virtual para o tempo dos eventos, se necessário
+        if (release_time > virtual_clock_time)
+        {
+            virtual_clock_time = release_time;
+        }
+
+        // Despacha os eventos para o kernel com uma única publicação
+        Kernel__dispatch_events_batch(batch, batch_size);
 
         pthread_mutex_unlock(&clock_mutex);
 
-        free(next_event); // Libera o container do evento
+        // Devolve os containers dos eventos ao pool
+        for (int i = 0; i < batch_size; i++)
+        {
+            release_kernel_event(released_events[i]);
+        }
     }
     return NULL;
 }
@@ -51,9 +94,14 @@ void *clock_thread_runner(void *args)
 // Inicializa o clock virtual e a thread de eventos
 void Clock__initialize()
 {
-    future_events_queue = create_list();    // Cria a fila de eventos
+    future_events_queue = create_heap(compare_event_time); // Cria a fila de eventos
     pthread_mutex_init(&clock_mutex, NULL); // Inicializa o mutex
-    pthread_cond_init(&clock_cond, NULL);   // Inicializa a variável de condição
+    // A variável de condição usa CLOCK_MONOTONIC, como os prazos calculados pela escala de tempo
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&clock_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
 
     pthread_t clock_tid;
     pthread_create(&clock_tid, NULL, clock_thread_runner, NULL); // Cria a thread do clock
@@ -61,25 +109,36 @@ void Clock__initialize()
 }
 
 // Agenda um novo evento para ocorrer após um certo delay
-void Clock__schedule_event(long long delay, EventType type, void *data)
+// Retorna o instante virtual em que o evento ocorrerá (-1 em caso de falha)
+long long Clock__schedule_event(long long delay, EventType type, void *data)
 {
     pthread_mutex_lock(&clock_mutex);
 
-    KernelEvent *new_event = malloc(sizeof(KernelEvent));
+    KernelEvent *new_event = allocate_kernel_event();
     if (new_event == NULL)
     {
         pthread_mutex_unlock(&clock_mutex);
-        return; // Falha na alocação
+        return -1; // Falha na alocação
     }
 
     new_event->type = type;
     new_event->data = data;
     new_event->execution_time = virtual_clock_time + delay; // Define o tempo de execução
+    new_event->sequence = next_event_sequence++;
+    new_event->process_id = Kernel__get_event_process_id(type, data);
 
-    add_to_list_sorted(future_events_queue, new_event, compare_event_time); // Insere ordenado
+    if (heap_push(future_events_queue, new_event) != 0) // Insere no heap em O(log n)
+    {
+        pthread_mutex_unlock(&clock_mutex);
+        release_kernel_event(new_event);
+        return -1; // Falha ao crescer o heap
+    }
+
+    long long execution_time = new_event->execution_time;
 
     pthread_cond_signal(&clock_cond); // Sinaliza que há um novo evento
     pthread_mutex_unlock(&clock_mutex);
+    return execution_time;
 }
 
 // Retorna o tempo virtual atual
@@ -87,3 +146,47 @@ long long Clock__get_time()
 {
     return virtual_clock_time;
 }
+
+// Registra um trabalho em andamento no instante atual
+void Clock__begin_activity()
+{
+    if (!kernel_config.deterministic)
+        return;
+    __atomic_fetch_add(&pending_activity_count, 1, __ATOMIC_ACQ_REL);
+}
+
+// Conclui um trabalho; o último a terminar acorda a thread do clock
+void Clock__end_activity()
+{
+    if (!kernel_config.deterministic)
+        return;
+    if (__atomic_sub_fetch(&pending_activity_count, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        pthread_mutex_lock(&clock_mutex);
+        pthread_cond_signal(&clock_cond);
+        pthread_mutex_unlock(&clock_mutex);
+    }
+    // Com vários núcleos, um núcleo pode estar esperando o fim deste trabalho para executar.
+    CPU__notify_activity_finished();
+}
+
+int Clock__get_pending_activity()
+{
+    return __atomic_load_n(&pending_activity_count, __ATOMIC_ACQUIRE);
+}
+
+int Clock__get_pending_event_count()
+{
+    pthread_mutex_lock(&clock_mutex);
+    int count = future_events_queue->size;
+    pthread_mutex_unlock(&clock_mutex);
+    return count;
+}
+
+// Acorda a thread do clock para reavaliar a cabeça da fila (ex: após mudança de velocidade)
+void Clock__wake()
+{
+    pthread_mutex_lock(&clock_mutex);
+    pthread_cond_broadcast(&clock_cond);
+    pthread_mutex_unlock(&clock_mutex);
+}
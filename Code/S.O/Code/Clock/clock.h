@@ -7,9 +7,26 @@
 void Clock__initialize();
 
 // Agenda um evento para ocorrer após um certo 'delay' (em unidades de tempo)
-void Clock__schedule_event(long long delay, EventType type, void *data);
+// Retorna o instante virtual agendado, ou -1 em caso de falha
+long long Clock__schedule_event(long long delay, EventType type, void *data);
 
 // Retorna o tempo atual do relógio virtual
 long long Clock__get_time();
 
+// Acorda a thread do clock para que reavalie o próximo evento (ex: mudança na escala de tempo)
+void Clock__wake();
+
+// Marcam o início/fim de um trabalho pertencente ao instante virtual atual
+// (evento em tratamento, pedido de I/O pendente, CPU com instruções a executar).
+// No modo determinístico o clock só libera o próximo evento quando não há
+// nenhum trabalho em andamento; fora dele, as chamadas não têm efeito.
+void Clock__begin_activity();
+void Clock__end_activity();
+
+// Quantidade de trabalhos em andamento no instante atual (sempre 0 fora do modo determinístico)
+int Clock__get_pending_activity();
+
+// Quantidade de eventos agendados que ainda não foram liberados
+int Clock__get_pending_event_count();
+
 #endif // CLOCK_H_GUARD
\ No newline at end of file
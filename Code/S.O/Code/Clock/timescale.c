@@ -0,0 +1,264 @@
+#include "timescale.h"
+#include "clock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_STEP_DELAY_US 200000 // Pausa original da interface: 0.2 s por instrução
+#define REALTIME_NS_PER_UNIT 1000    // "realtime": 1 unidade virtual = 1 us
+#define MIN_STEP_DELAY_US 1
+#define MAX_STEP_DELAY_US 10000000   // 10 s por instrução
+#define MIN_NS_PER_UNIT 1
+#define MAX_NS_PER_UNIT 1000000000LL // 1 s por unidade virtual
+#define MAX_LAG_NS 50000000LL        // Atraso tolerado antes de reancorar a escala (50 ms)
+
+// Estado da escala (protegido por timescale_mutex)
+static TimescaleMode current_mode = TIMESCALE_STEP;
+static int step_delay_us = DEFAULT_STEP_DELAY_US;
+static long long ns_per_unit = REALTIME_NS_PER_UNIT;
+
+// Avanço rápido: guarda o modo anterior enquanto roda em afap
+static int fast_forward_active = 0;
+static TimescaleMode mode_before_fast_forward = TIMESCALE_STEP;
+
+// Âncora do modo ratio: o tempo virtual 'anchor_virtual' corresponde ao instante real 'anchor_wall'
+static int anchor_valid = 0;
+static long long anchor_virtual = 0;
+static long long anchor_wall_ns = 0;
+
+// Incrementado a cada mudança de velocidade, para interromper pausas em andamento
+static unsigned long change_generation = 0;
+
+static pthread_mutex_t timescale_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timescale_cond;
+static pthread_once_t timescale_cond_once = PTHREAD_ONCE_INIT;
+
+// -----------------------------------------------------------------------------
+// Funções auxiliares de tempo real
+// -----------------------------------------------------------------------------
+
+static long long monotonic_now_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static void ns_to_timespec(long long ns, struct timespec *ts)
+{
+    ts->tv_sec = ns / 1000000000LL;
+    ts->tv_nsec = ns % 1000000000LL;
+}
+
+// A condição usa CLOCK_MONOTONIC, para que ajustes no relógio do sistema não afetem as pausas
+static void init_timescale_cond()
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timescale_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+// Registra uma mudança de velocidade e acorda quem está pausado (CPU e clock).
+// Chamada com timescale_mutex travado; o clock é acordado após destravar.
+static void notify_change()
+{
+    anchor_valid = 0; // A nova escala é ancorada no próximo evento
+    change_generation++;
+    pthread_cond_broadcast(&timescale_cond);
+}
+
+// Lê um inteiro positivo após o prefixo 'prefix' em 'spec'. Retorna -1 se inválido.
+static long long parse_spec_value(const char *spec, const char *prefix)
+{
+    size_t prefix_len = strlen(prefix);
+    if (strncmp(spec, prefix, prefix_len) != 0)
+        return -1;
+    char *end_ptr;
+    long long value = strtoll(spec + prefix_len, &end_ptr, 10);
+    if (spec[prefix_len] == '\0' || *end_ptr != '\0' || value <= 0)
+        return -1;
+    return value;
+}
+
+// -----------------------------------------------------------------------------
+// Configuração
+// -----------------------------------------------------------------------------
+
+int Timescale__configure(const char *spec)
+{
+    long long value;
+    pthread_once(&timescale_cond_once, init_timescale_cond);
+    pthread_mutex_lock(&timescale_mutex);
+    if (strcmp(spec, "afap") == 0)
+    {
+        current_mode = TIMESCALE_AFAP;
+    }
+    else if (strcmp(spec, "realtime") == 0)
+    {
+        current_mode = TIMESCALE_RATIO;
+        ns_per_unit = REALTIME_NS_PER_UNIT;
+    }
+    else if ((value = parse_spec_value(spec, "step:")) > 0 && value <= MAX_STEP_DELAY_US)
+    {
+        current_mode = TIMESCALE_STEP;
+        step_delay_us = (int)value;
+    }
+    else if ((value = parse_spec_value(spec, "ratio:")) > 0 && value <= MAX_NS_PER_UNIT)
+    {
+        current_mode = TIMESCALE_RATIO;
+        ns_per_unit = value;
+    }
+    else
+    {
+        pthread_mutex_unlock(&timescale_mutex);
+        return -1;
+    }
+    fast_forward_active = 0;
+    notify_change();
+    pthread_mutex_unlock(&timescale_mutex);
+    return 0;
+}
+
+TimescaleMode Timescale__get_mode()
+{
+    pthread_mutex_lock(&timescale_mutex);
+    TimescaleMode mode = current_mode;
+    pthread_mutex_unlock(&timescale_mutex);
+    return mode;
+}
+
+// -----------------------------------------------------------------------------
+// Ritmo da CPU, do clock e da interface
+// -----------------------------------------------------------------------------
+
+void Timescale__pace_instruction()
+{
+    pthread_once(&timescale_cond_once, init_timescale_cond);
+    pthread_mutex_lock(&timescale_mutex);
+    if (current_mode == TIMESCALE_STEP)
+    {
+        unsigned long generation = change_generation;
+        struct timespec deadline;
+        ns_to_timespec(monotonic_now_ns() + (long long)step_delay_us * 1000LL, &deadline);
+        // Espera até o fim da pausa, ou até que a velocidade seja alterada
+        while (generation == change_generation)
+        {
+            if (pthread_cond_timedwait(&timescale_cond, &timescale_mutex, &deadline) != 0)
+                break;
+        }
+    }
+    pthread_mutex_unlock(&timescale_mutex);
+}
+
+int Timescale__get_event_deadline(long long virtual_time, long long virtual_now, struct timespec *deadline)
+{
+    pthread_mutex_lock(&timescale_mutex);
+    if (current_mode != TIMESCALE_RATIO)
+    {
+        pthread_mutex_unlock(&timescale_mutex);
+        return 0;
+    }
+
+    long long now_ns = monotonic_now_ns();
+    if (!anchor_valid)
+    {
+        anchor_virtual = virtual_now;
+        anchor_wall_ns = now_ns;
+        anchor_valid = 1;
+    }
+
+    long long target_ns = anchor_wall_ns + (virtual_time - anchor_virtual) * ns_per_unit;
+    if (target_ns <= now_ns)
+    {
+        // A simulação está atrasada (ex: handlers lentos ou clock parado aguardando
+        // eventos). Acima do limite, a escala é reancorada em vez de recuperar o
+        // atraso liberando uma rajada de eventos.
+        if (now_ns - target_ns > MAX_LAG_NS)
+        {
+            anchor_virtual = virtual_time;
+            anchor_wall_ns = now_ns;
+        }
+        pthread_mutex_unlock(&timescale_mutex);
+        return 0;
+    }
+    ns_to_timespec(target_ns, deadline);
+    pthread_mutex_unlock(&timescale_mutex);
+    return 1;
+}
+
+void Timescale__wait_ui_frame()
+{
+    usleep(TIMESCALE_UI_FRAME_US);
+}
+
+// -----------------------------------------------------------------------------
+// Controles de velocidade em tempo de execução
+// -----------------------------------------------------------------------------
+
+void Timescale__faster()
+{
+    pthread_mutex_lock(&timescale_mutex);
+    if (current_mode == TIMESCALE_STEP && step_delay_us > MIN_STEP_DELAY_US)
+        step_delay_us /= 2;
+    else if (current_mode == TIMESCALE_RATIO && ns_per_unit > MIN_NS_PER_UNIT)
+        ns_per_unit /= 2;
+    notify_change();
+    pthread_mutex_unlock(&timescale_mutex);
+    Clock__wake();
+}
+
+void Timescale__slower()
+{
+    pthread_mutex_lock(&timescale_mutex);
+    if (current_mode == TIMESCALE_STEP && step_delay_us <= MAX_STEP_DELAY_US / 2)
+        step_delay_us *= 2;
+    else if (current_mode == TIMESCALE_RATIO && ns_per_unit <= MAX_NS_PER_UNIT / 2)
+        ns_per_unit *= 2;
+    notify_change();
+    pthread_mutex_unlock(&timescale_mutex);
+    Clock__wake();
+}
+
+void Timescale__toggle_fast_forward()
+{
+    pthread_mutex_lock(&timescale_mutex);
+    if (fast_forward_active)
+    {
+        current_mode = mode_before_fast_forward;
+        fast_forward_active = 0;
+    }
+    else
+    {
+        mode_before_fast_forward = current_mode;
+        current_mode = TIMESCALE_AFAP;
+        fast_forward_active = 1;
+    }
+    notify_change();
+    pthread_mutex_unlock(&timescale_mutex);
+    Clock__wake();
+}
+
+void Timescale__describe(char *buffer, size_t buffer_size)
+{
+    pthread_mutex_lock(&timescale_mutex);
+    switch (current_mode)
+    {
+    case TIMESCALE_AFAP:
+        snprintf(buffer, buffer_size, fast_forward_active ? "avanco rapido" : "maxima");
+        break;
+    case TIMESCALE_STEP:
+        if (step_delay_us >= 1000)
+            snprintf(buffer, buffer_size, "passo %dms", step_delay_us / 1000);
+        else
+            snprintf(buffer, buffer_size, "passo %dus", step_delay_us);
+        break;
+    case TIMESCALE_RATIO:
+        snprintf(buffer, buffer_size, "1u = %lldns", ns_per_unit);
+        break;
+    }
+    pthread_mutex_unlock(&timescale_mutex);
+}
@@ -0,0 +1,77 @@
+#ifndef TIMESCALE_H_GUARD
+#define TIMESCALE_H_GUARD
+
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+
+// -----------------------------------------------------------------------------
+// Escala de tempo da simulação: define a relação entre tempo virtual e tempo real.
+// Todo o ritmo da simulação (CPU, clock e interface) é controlado por este módulo.
+//
+// Modos:
+//   afap          - o mais rápido possível, sem nenhuma pausa;
+//   step:<us>     - pausa fixa de <us> microssegundos após cada instrução da CPU
+//                   (comportamento original da interface: step:200000);
+//   ratio:<ns>    - cada unidade de tempo virtual dura <ns> nanossegundos reais;
+//                   o clock só libera um evento quando o tempo real o alcança;
+//   realtime      - atalho para ratio:1000 (1 unidade virtual = 1 us).
+// -----------------------------------------------------------------------------
+
+typedef enum
+{
+    TIMESCALE_AFAP,  // Sem pausas
+    TIMESCALE_STEP,  // Pausa fixa por instrução da CPU
+    TIMESCALE_RATIO  // Tempo virtual proporcional ao tempo real
+} TimescaleMode;
+
+// Intervalo entre atualizações da interface (10 Hz)
+#define TIMESCALE_UI_FRAME_US 100000
+
+/**
+ * @brief Configura a escala a partir de uma especificação textual (ver modos acima).
+ * @return 0 em caso de sucesso, -1 se a especificação for inválida.
+ */
+int Timescale__configure(const char *spec);
+
+/**
+ * @brief Retorna o modo atual.
+ */
+TimescaleMode Timescale__get_mode();
+
+/**
+ * @brief Pausa a thread da CPU após uma instrução, conforme o modo atual.
+ * Mudanças de velocidade interrompem a pausa em andamento.
+ */
+void Timescale__pace_instruction();
+
+/**
+ * @brief Calcula o instante real (CLOCK_MONOTONIC) em que o tempo virtual
+ * 'virtual_time' deve ser alcançado.
+ *
+ * @param virtual_now  Tempo virtual atual do clock (usado para reancorar a escala).
+ * @param deadline     Recebe o instante real correspondente.
+ * @return 1 se o clock deve esperar até 'deadline', 0 se o evento já pode ser liberado.
+ */
+int Timescale__get_event_deadline(long long virtual_time, long long virtual_now, struct timespec *deadline);
+
+/**
+ * @brief Pausa a thread da interface entre dois redesenhos da tela.
+ */
+void Timescale__wait_ui_frame();
+
+/**
+ * @brief Controles de velocidade em tempo de execução (usados pela interface).
+ * faster/slower dobram ou reduzem à metade a velocidade do modo atual;
+ * toggle_fast_forward alterna entre o modo atual e afap.
+ */
+void Timescale__faster();
+void Timescale__slower();
+void Timescale__toggle_fast_forward();
+
+/**
+ * @brief Escreve em 'buffer' uma descrição curta do modo atual (ex: "passo 200ms").
+ */
+void Timescale__describe(char *buffer, size_t buffer_size);
+
+#endif // TIMESCALE_H_GUARD
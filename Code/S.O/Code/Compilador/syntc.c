@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------
+// syntc: compilador de programas .synt para o formato binário .syntb.
+//
+// O simulador carrega o .syntb mapeando o arquivo em memória, sem interpretar
+// texto: útil para cargas grandes que são reexecutadas muitas vezes.
+//
+// Uso: ./syntc <arquivo.synt> [...]          (gera <arquivo>.syntb ao lado de cada um)
+//      ./syntc -o <saida.syntb> <arquivo.synt>
+// -----------------------------------------------------------------------------
+#include "../Process/program.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Monta o caminho de saída: troca a extensão .synt por .syntb, ou acrescenta .syntb.
+static char *default_output_path(const char *input_path)
+{
+    size_t length = strlen(input_path);
+    char *output_path = malloc(length + sizeof(".syntb"));
+    if (output_path == NULL)
+        return NULL;
+    strcpy(output_path, input_path);
+    if (length >= 5 && strcmp(input_path + length - 5, ".synt") == 0)
+        output_path[length - 5] = '\0';
+    strcat(output_path, ".syntb");
+    return output_path;
+}
+
+// Compila um arquivo. Retorna 0 em caso de sucesso.
+static int compile_file(const char *input_path, const char *output_path)
+{
+    char error_message[512];
+    Program *program = Program__load_file(input_path, error_message, sizeof(error_message));
+    if (program == NULL)
+    {
+        fprintf(stderr, "syntc: %s\n", error_message);
+        return -1;
+    }
+    int result = Program__write_binary(program, output_path, error_message, sizeof(error_message));
+    if (result != 0)
+        fprintf(stderr, "syntc: %s\n", error_message);
+    else
+        printf("%s -> %s (%d instrucoes)\n", input_path, output_path, program->instruction_count);
+    Program__release(program);
+    return result;
+}
+
+static void print_usage()
+{
+    fprintf(stderr, "Uso: syntc <arquivo.synt> [...]\n");
+    fprintf(stderr, "     syntc -o <saida.syntb> <arquivo.synt>\n");
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && strcmp(argv[1], "-o") == 0)
+    {
+        if (argc != 4)
+        {
+            print_usage();
+            return 1;
+        }
+        return compile_file(argv[3], argv[2]) == 0 ? 0 : 1;
+    }
+    if (argc < 2)
+    {
+        print_usage();
+        return 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        char *output_path = default_output_path(argv[i]);
+        if (output_path == NULL || compile_file(argv[i], output_path) != 0)
+            failures++;
+        free(output_path);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+#include "heap.h"
+#include <stdlib.h>
+
+#define HEAP_INITIAL_CAPACITY 64
+
+// Cria e inicializa um heap vazio.
+Heap *create_heap(int (*compare)(void *, void *))
+{
+    Heap *new_heap = malloc(sizeof(Heap));
+    if (new_heap == NULL)
+    {
+        return NULL;
+    }
+    new_heap->items = malloc(sizeof(void *) * HEAP_INITIAL_CAPACITY);
+    if (new_heap->items == NULL)
+    {
+        free(new_heap);
+        return NULL;
+    }
+    new_heap->size = 0;
+    new_heap->capacity = HEAP_INITIAL_CAPACITY;
+    new_heap->compare = compare;
+    return new_heap;
+}
+
+// Libera o vetor e a estrutura do heap (não libera os dados armazenados).
+void destroy_heap(Heap *heap)
+{
+    free(heap->items);
+    free(heap);
+}
+
+// Sobe o elemento da posição 'index' até que o pai seja menor ou igual a ele.
+static void sift_up(Heap *heap, int index)
+{
+    void *moving_item = heap->items[index];
+    while (index > 0)
+    {
+        int parent_index = (index - 1) / HEAP_ARITY;
+        if (heap->compare(moving_item, heap->items[parent_index]) >= 0)
+        {
+            break;
+        }
+        heap->items[index] = heap->items[parent_index];
+        index = parent_index;
+    }
+    heap->items[index] = moving_item;
+}
+
+// Desce o elemento da posição 'index' trocando-o com o menor dos filhos.
+static void sift_down(Heap *heap, int index)
+{
+    void *moving_item = heap->items[index];
+    while (1)
+    {
+        int first_child = index * HEAP_ARITY + 1;
+        if (first_child >= heap->size)
+        {
+            break;
+        }
+        int last_child = first_child + HEAP_ARITY;
+        if (last_child > heap->size)
+        {
+            last_child = heap->size;
+        }
+        int smallest_child = first_child;
+        for (int child = first_child + 1; child < last_child; child++)
+        {
+            if (heap->compare(heap->items[child], heap->items[smallest_child]) < 0)
+            {
+                smallest_child = child;
+            }
+        }
+        if (heap->compare(heap->items[smallest_child], moving_item) >= 0)
+        {
+            break;
+        }
+        heap->items[index] = heap->items[smallest_child];
+        index = smallest_child;
+    }
+    heap->items[index] = moving_item;
+}
+
+// Insere um elemento no heap, dobrando a capacidade do vetor quando necessário.
+int heap_push(Heap *heap, void *data)
+{
+    if (heap->size == heap->capacity)
+    {
+        void **grown_items = realloc(heap->items, sizeof(void *) * heap->capacity * 2);
+        if (grown_items == NULL)
+        {
+            return -1;
+        }
+        heap->items = grown_items;
+        heap->capacity *= 2;
+    }
+    heap->items[heap->size] = data;
+    heap->size++;
+    sift_up(heap, heap->size - 1);
+    return 0;
+}
+
+// Remove o menor elemento: o último elemento ocupa a raiz e desce até sua posição.
+void *heap_pop(Heap *heap)
+{
+    if (heap->size == 0)
+    {
+        return NULL;
+    }
+    void *min_item = heap->items[0];
+    heap->size--;
+    if (heap->size > 0)
+    {
+        heap->items[0] = heap->items[heap->size];
+        sift_down(heap, 0);
+    }
+    return min_item;
+}
+
+// Consulta o menor elemento sem removê-lo.
+void *heap_peek(Heap *heap)
+{
+    return heap->size > 0 ? heap->items[0] : NULL;
+}
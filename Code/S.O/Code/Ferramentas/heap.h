@@ -0,0 +1,36 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+// Heap de mínimo d-ário (d = HEAP_ARITY) armazenado em vetor contíguo.
+// Cada posição guarda um ponteiro genérico; a ordem é definida por uma função
+// de comparação no mesmo formato das usadas pela lista (negativo se a < b).
+// Inserção e remoção do mínimo custam O(log n); consulta ao mínimo, O(1).
+
+#define HEAP_ARITY 4
+
+typedef struct Heap_t
+{
+    void **items;                    // Vetor de elementos (items[0] é o mínimo)
+    int size;                        // Quantidade de elementos no heap
+    int capacity;                    // Capacidade alocada do vetor
+    int (*compare)(void *, void *);  // Função de comparação entre elementos
+} Heap;
+
+/* ---------- Operações Básicas do Heap ---------- */
+
+// Cria e retorna um heap vazio que ordena seus elementos pela função informada.
+Heap *create_heap(int (*compare)(void *, void *));
+
+// Libera o heap (mas não o conteúdo apontado pelos elementos).
+void destroy_heap(Heap *heap);
+
+// Insere um elemento. Retorna 0 em caso de sucesso, -1 se faltar memória.
+int heap_push(Heap *heap, void *data);
+
+// Remove e retorna o menor elemento, ou NULL se o heap estiver vazio.
+void *heap_pop(Heap *heap);
+
+// Retorna o menor elemento sem removê-lo, ou NULL se o heap estiver vazio.
+void *heap_peek(Heap *heap);
+
+#endif // HEAP_H
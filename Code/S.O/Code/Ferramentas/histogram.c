@@ -0,0 +1,73 @@
+#include "histogram.h"
+#include <string.h>
+
+// Índice da faixa de um valor. Valores menores que HISTOGRAM_SUB_BUCKET_COUNT têm
+// faixa própria; acima disso, os HISTOGRAM_SUB_BUCKET_BITS bits mais significativos
+// escolhem a sub-faixa dentro da potência de dois do valor.
+static int bucket_index(long long value)
+{
+    if (value < HISTOGRAM_SUB_BUCKET_COUNT)
+        return (int)value;
+    int highest_bit = 63 - __builtin_clzll((unsigned long long)value);
+    int exponent = highest_bit - (HISTOGRAM_SUB_BUCKET_BITS - 1);
+    if (exponent > HISTOGRAM_MAX_EXPONENT)
+        return HISTOGRAM_BUCKET_COUNT - 1;
+    int mantissa = (int)(value >> exponent); // Entre SUB_BUCKET_HALF e SUB_BUCKET_COUNT - 1
+    return HISTOGRAM_SUB_BUCKET_COUNT + (exponent - 1) * HISTOGRAM_SUB_BUCKET_HALF +
+           (mantissa - HISTOGRAM_SUB_BUCKET_HALF);
+}
+
+// Maior valor que cai na faixa informada.
+static long long bucket_upper_bound(int index)
+{
+    if (index < HISTOGRAM_SUB_BUCKET_COUNT)
+        return index;
+    int offset = index - HISTOGRAM_SUB_BUCKET_COUNT;
+    int exponent = offset / HISTOGRAM_SUB_BUCKET_HALF + 1;
+    long long mantissa = offset % HISTOGRAM_SUB_BUCKET_HALF + HISTOGRAM_SUB_BUCKET_HALF;
+    return ((mantissa + 1) << exponent) - 1;
+}
+
+void histogram_reset(Histogram *histogram)
+{
+    memset(histogram, 0, sizeof(Histogram));
+}
+
+void histogram_record(Histogram *histogram, long long value)
+{
+    if (value < 0)
+        value = 0;
+    histogram->counts[bucket_index(value)]++;
+    histogram->total_count++;
+    histogram->total_sum += value;
+    if (value > histogram->max_value)
+        histogram->max_value = value;
+}
+
+long long histogram_value_at_percentile(Histogram *histogram, double percentile)
+{
+    if (histogram->total_count == 0)
+        return 0;
+    // Posição (a partir de 1) do valor procurado na sequência ordenada
+    long long target_rank = (long long)(percentile / 100.0 * histogram->total_count + 0.5);
+    if (target_rank < 1)
+        target_rank = 1;
+    long long seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        seen += histogram->counts[i];
+        if (seen >= target_rank)
+        {
+            long long upper_bound = bucket_upper_bound(i);
+            return upper_bound < histogram->max_value ? upper_bound : histogram->max_value;
+        }
+    }
+    return histogram->max_value;
+}
+
+double histogram_mean(Histogram *histogram)
+{
+    if (histogram->total_count == 0)
+        return 0.0;
+    return (double)histogram->total_sum / histogram->total_count;
+}
@@ -0,0 +1,37 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+// Histograma de latências log-linear (no estilo HDR): cada potência de dois é
+// dividida em sub-faixas lineares, o que mantém o erro relativo de cada valor
+// registrado abaixo de 1/HISTOGRAM_SUB_BUCKET_HALF (~3%) em toda a escala,
+// com memória fixa e registro em O(1).
+
+#define HISTOGRAM_SUB_BUCKET_BITS 5
+#define HISTOGRAM_SUB_BUCKET_COUNT (1 << HISTOGRAM_SUB_BUCKET_BITS)  // 32
+#define HISTOGRAM_SUB_BUCKET_HALF (HISTOGRAM_SUB_BUCKET_COUNT / 2)   // 16
+#define HISTOGRAM_MAX_EXPONENT 40                                    // Valores até ~2^45
+#define HISTOGRAM_BUCKET_COUNT (HISTOGRAM_SUB_BUCKET_COUNT + HISTOGRAM_MAX_EXPONENT * HISTOGRAM_SUB_BUCKET_HALF)
+
+typedef struct Histogram_t
+{
+    long long counts[HISTOGRAM_BUCKET_COUNT]; // Quantidade de valores em cada faixa
+    long long total_count;                    // Quantidade total de valores registrados
+    long long total_sum;                      // Soma dos valores (para a média)
+    long long max_value;                      // Maior valor registrado
+} Histogram;
+
+/* ---------- Operações do Histograma ---------- */
+
+// Zera todas as contagens.
+void histogram_reset(Histogram *histogram);
+
+// Registra um valor (valores negativos contam como 0; valores acima da escala, na última faixa).
+void histogram_record(Histogram *histogram, long long value);
+
+// Retorna o valor no percentil informado (0 a 100), arredondado para o limite superior da faixa.
+long long histogram_value_at_percentile(Histogram *histogram, double percentile);
+
+// Retorna a média dos valores registrados (0 se vazio).
+double histogram_mean(Histogram *histogram);
+
+#endif // HISTOGRAM_H
@@ -135,6 +135,26 @@ void remove_from_list(List *list_ptr, void *data_content, int (*compare_func)(vo
     list_ptr->size--;
 }
 
+// Remove o primeiro elemento da lista em O(1) e retorna o ponteiro para seus dados.
+// Retorna NULL se a lista estiver vazia. Não libera o conteúdo, apenas o nó.
+void *remove_first_from_list(List *list_ptr)
+{
+    Node *first_node = list_ptr->head;
+    if (first_node == NULL)
+    {
+        return NULL;
+    }
+    void *data_content = first_node->data;
+    list_ptr->head = first_node->next;
+    if (list_ptr->head == NULL)
+    { // Lista ficou vazia
+        list_ptr->tail = NULL;
+    }
+    free(first_node);
+    list_ptr->size--;
+    return data_content;
+}
+
 // Libera toda a memória da lista e seus nós (mas não dos dados armazenados).
 void destroy_list(List *list_ptr)
 {
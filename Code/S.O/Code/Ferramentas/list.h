@@ -51,6 +51,10 @@ void add_to_list_sorted(List *list, void *data,
 void remove_from_list(List *list, void *data,
                       int (*compare)(void *, void *));
 
+// Remove o primeiro elemento da lista em tempo constante.
+// Retorna o ponteiro para os dados removidos, ou NULL se a lista estiver vazia.
+void *remove_first_from_list(List *list);
+
 // Verifica se um elemento existe na lista (retorna 1 se existir, 0 caso contrário).
 // Parâmetros: ponteiro para a lista, ponteiro para a chave e função de comparação.
 int exists_in_list(List *list, void *key,
@@ -0,0 +1,161 @@
+#include "mpsc_queue.h"
+#include <linux/futex.h> // Para FUTEX_WAIT_PRIVATE e FUTEX_WAKE_PRIVATE
+#include <sys/syscall.h> // Para SYS_futex
+#include <unistd.h>      // Para syscall
+#include <sched.h>       // Para sched_yield
+#include <stddef.h>      // Para NULL
+
+// Quantas tentativas o consumidor faz antes de dormir no futex.
+#define MPSC_SPIN_ATTEMPTS 256
+
+// Dica ao processador de que a thread está em espera ativa.
+static inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static void futex_wait(atomic_uint *address, unsigned int expected_value)
+{
+    syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected_value, NULL, NULL, 0);
+}
+
+static void futex_wake_one(atomic_uint *address)
+{
+    syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+// Inicializa a fila apontando cabeça e cauda para o nó sentinela.
+void mpsc_queue_init(MpscQueue *queue)
+{
+    atomic_store_explicit(&queue->stub.next, NULL, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, &queue->stub, memory_order_relaxed);
+    queue->head = &queue->stub;
+    atomic_store(&queue->consumer_sleeping, 0);
+    atomic_store(&queue->wakeup_futex, 0);
+}
+
+// Encadeia a cadeia first..last na cauda. Entre a troca da cauda e a ligação do nó
+// anterior, a fila fica momentaneamente "em publicação"; o consumidor apenas aguarda.
+static void link_chain(MpscQueue *queue, MpscNode *first, MpscNode *last)
+{
+    atomic_store_explicit(&last->next, NULL, memory_order_relaxed);
+    MpscNode *previous_tail = atomic_exchange_explicit(&queue->tail, last, memory_order_seq_cst);
+    atomic_store_explicit(&previous_tail->next, first, memory_order_release);
+}
+
+static void link_node(MpscQueue *queue, MpscNode *node)
+{
+    link_chain(queue, node, node);
+}
+
+// Acorda o consumidor, pagando a chamada de sistema só se ele estiver (ou for) dormir.
+static void wake_consumer(MpscQueue *queue)
+{
+    if (atomic_load(&queue->consumer_sleeping))
+    {
+        atomic_fetch_add(&queue->wakeup_futex, 1);
+        futex_wake_one(&queue->wakeup_futex);
+    }
+}
+
+void mpsc_queue_push(MpscQueue *queue, MpscNode *node)
+{
+    link_node(queue, node);
+    wake_consumer(queue);
+}
+
+void mpsc_queue_push_chain(MpscQueue *queue, MpscNode *first, MpscNode *last)
+{
+    link_chain(queue, first, last);
+    wake_consumer(queue);
+}
+
+MpscNode *mpsc_queue_pop(MpscQueue *queue)
+{
+    MpscNode *head = queue->head;
+    MpscNode *next = atomic_load_explicit(&head->next, memory_order_acquire);
+
+    // Pula o sentinela, se ele estiver na cabeça.
+    if (head == &queue->stub)
+    {
+        if (next == NULL)
+        {
+            return NULL; // Fila vazia
+        }
+        queue->head = next;
+        head = next;
+        next = atomic_load_explicit(&head->next, memory_order_acquire);
+    }
+
+    if (next != NULL)
+    {
+        queue->head = next;
+        return head;
+    }
+
+    // 'head' é o último nó ligado. Se a cauda já avançou, um produtor ainda está publicando.
+    if (head != atomic_load_explicit(&queue->tail, memory_order_acquire))
+    {
+        return NULL;
+    }
+
+    // Reinsere o sentinela para poder retirar o último nó.
+    link_node(queue, &queue->stub);
+    next = atomic_load_explicit(&head->next, memory_order_acquire);
+    if (next != NULL)
+    {
+        queue->head = next;
+        return head;
+    }
+    return NULL;
+}
+
+MpscNode *mpsc_queue_pop_wait(MpscQueue *queue)
+{
+    // Fase 1: espera ativa curta, barata quando os eventos chegam em rajadas.
+    for (int attempt = 0; attempt < MPSC_SPIN_ATTEMPTS; attempt++)
+    {
+        MpscNode *node = mpsc_queue_pop(queue);
+        if (node != NULL)
+        {
+            return node;
+        }
+        cpu_relax();
+    }
+
+    // Fase 2: anuncia que vai dormir e confere a fila mais uma vez antes de dormir.
+    while (1)
+    {
+        MpscNode *node = mpsc_queue_pop(queue);
+        if (node != NULL)
+        {
+            return node;
+        }
+
+        atomic_store(&queue->consumer_sleeping, 1);
+        unsigned int wakeup_value = atomic_load(&queue->wakeup_futex);
+
+        node = mpsc_queue_pop(queue);
+        if (node != NULL)
+        {
+            atomic_store(&queue->consumer_sleeping, 0);
+            return node;
+        }
+
+        // Vazia de fato só quando cabeça e cauda estão no sentinela; qualquer outro
+        // estado indica uma publicação em andamento.
+        if (queue->head != &queue->stub || atomic_load(&queue->tail) != &queue->stub)
+        {
+            // Há uma publicação em andamento: não vale a pena dormir.
+            atomic_store(&queue->consumer_sleeping, 0);
+            sched_yield();
+            continue;
+        }
+
+        // A fila está realmente vazia: dorme até um produtor incrementar o futex.
+        futex_wait(&queue->wakeup_futex, wakeup_value);
+        atomic_store(&queue->consumer_sleeping, 0);
+    }
+}
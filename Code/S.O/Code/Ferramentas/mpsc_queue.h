@@ -0,0 +1,48 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <stdatomic.h>
+
+// Fila intrusiva sem travas com múltiplos produtores e um único consumidor
+// (algoritmo de Dmitry Vyukov). Cada elemento embute um MpscNode, de preferência
+// como primeiro campo, para que o consumidor recupere a estrutura com um cast.
+//
+// Produtores publicam com uma única troca atômica na cauda; o consumidor retira
+// da cabeça sem travas. Quando a fila está de fato vazia, o consumidor gira por
+// um curto período e então dorme em um futex, sendo acordado pelo próximo produtor.
+
+typedef struct MpscNode_t
+{
+    struct MpscNode_t *_Atomic next; // Próximo nó da fila
+} MpscNode;
+
+typedef struct MpscQueue_t
+{
+    MpscNode *_Atomic tail;           // Último nó publicado (disputado pelos produtores)
+    MpscNode *head;                   // Próximo nó a consumir (usado só pelo consumidor)
+    MpscNode stub;                    // Nó sentinela que mantém a fila sempre não vazia
+    atomic_int consumer_sleeping;     // 1 enquanto o consumidor se prepara para dormir
+    atomic_uint wakeup_futex;         // Palavra do futex onde o consumidor dorme
+} MpscQueue;
+
+/* ---------- Operações da Fila ---------- */
+
+// Inicializa uma fila vazia.
+void mpsc_queue_init(MpscQueue *queue);
+
+// Publica um nó (seguro para qualquer número de produtores concorrentes).
+void mpsc_queue_push(MpscQueue *queue, MpscNode *node);
+
+// Publica de uma vez uma cadeia de nós já ligada de 'first' a 'last' (pelo campo next;
+// o next de 'last' é zerado aqui). Custa uma única troca atômica e, no máximo, um despertar.
+void mpsc_queue_push_chain(MpscQueue *queue, MpscNode *first, MpscNode *last);
+
+// Remove o próximo nó sem bloquear. Retorna NULL se a fila estiver vazia
+// ou se um produtor ainda estiver concluindo uma publicação.
+// Só pode ser chamada pelo consumidor.
+MpscNode *mpsc_queue_pop(MpscQueue *queue);
+
+// Remove o próximo nó, bloqueando até que haja um. Só pode ser chamada pelo consumidor.
+MpscNode *mpsc_queue_pop_wait(MpscQueue *queue);
+
+#endif // MPSC_QUEUE_H
@@ -0,0 +1,273 @@
+#include "object_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define OBJECT_POOL_SLAB_OBJECTS 64   // Objetos criados por chamada de malloc
+#define THREAD_CACHE_MAX_OBJECTS 128  // Limite do cache de uma thread antes de devolver à lista global
+#define THREAD_CACHE_BATCH 64         // Objetos trocados por vez com a lista global
+#define OBJECT_POOL_ALIGNMENT 16
+
+// Objeto livre: enquanto está em uma lista, os primeiros bytes guardam o próximo livre.
+typedef struct FreeObject_t
+{
+    struct FreeObject_t *next;
+} FreeObject;
+
+// Cache de uma thread para um pool. Os contadores só são escritos pela thread dona;
+// as estatísticas os leem de outras threads com cargas atômicas relaxadas.
+typedef struct
+{
+    FreeObject *free_list;
+    int free_count;
+    long long allocations;
+    long long cache_hits;
+} ThreadCache;
+
+// Conjunto de caches de uma thread, registrado globalmente para as estatísticas.
+// É alocado no heap (e nunca liberado) para continuar válido se a thread terminar.
+typedef struct ThreadCacheSet_t
+{
+    ThreadCache caches[OBJECT_POOL_MAX_POOLS];
+    struct ThreadCacheSet_t *next_set;
+} ThreadCacheSet;
+
+static __thread ThreadCacheSet *thread_cache_set = NULL;
+
+// Registro global de pools e de conjuntos de caches.
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+static ObjectPool *registered_pools[OBJECT_POOL_MAX_POOLS];
+static int registered_pool_count = 0;
+static ThreadCacheSet *registered_cache_sets = NULL;
+
+// Atribui um índice ao pool no primeiro uso.
+static int register_pool(ObjectPool *pool)
+{
+    pthread_mutex_lock(&registry_mutex);
+    if (pool->pool_id < 0)
+    {
+        // Tamanho arredondado para caber o ponteiro da lista livre e manter o alinhamento.
+        // Vale também para pools sem índice, que usam só a lista global.
+        size_t rounded_size = pool->object_size < sizeof(FreeObject) ? sizeof(FreeObject) : pool->object_size;
+        rounded_size = (rounded_size + OBJECT_POOL_ALIGNMENT - 1) & ~(size_t)(OBJECT_POOL_ALIGNMENT - 1);
+        if (pool->object_size != rounded_size)
+            pool->object_size = rounded_size;
+        if (registered_pool_count >= OBJECT_POOL_MAX_POOLS)
+        {
+            pthread_mutex_unlock(&registry_mutex);
+            return -1;
+        }
+        registered_pools[registered_pool_count] = pool;
+        __atomic_store_n(&pool->pool_id, registered_pool_count, __ATOMIC_RELEASE);
+        registered_pool_count++;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    return pool->pool_id;
+}
+
+// Retorna o cache da thread atual para o pool, criando-o se necessário.
+static ThreadCache *get_thread_cache(ObjectPool *pool)
+{
+    int pool_id = __atomic_load_n(&pool->pool_id, __ATOMIC_ACQUIRE);
+    if (__builtin_expect(pool_id < 0, 0))
+    {
+        pool_id = register_pool(pool);
+        if (pool_id < 0)
+            return NULL;
+    }
+    if (__builtin_expect(thread_cache_set == NULL, 0))
+    {
+        ThreadCacheSet *new_set = calloc(1, sizeof(ThreadCacheSet));
+        if (new_set == NULL)
+            return NULL;
+        pthread_mutex_lock(&registry_mutex);
+        new_set->next_set = registered_cache_sets;
+        registered_cache_sets = new_set;
+        pthread_mutex_unlock(&registry_mutex);
+        thread_cache_set = new_set;
+    }
+    return &thread_cache_set->caches[pool_id];
+}
+
+// Recarrega o cache da thread com um lote da lista global ou com um novo slab.
+static void refill_thread_cache(ObjectPool *pool, ThreadCache *cache)
+{
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->global_free_count > 0)
+    {
+        // Move até THREAD_CACHE_BATCH objetos da lista global para o cache.
+        int moved = 0;
+        while (pool->global_free_list != NULL && moved < THREAD_CACHE_BATCH)
+        {
+            FreeObject *object = (FreeObject *)pool->global_free_list;
+            pool->global_free_list = object->next;
+            object->next = cache->free_list;
+            cache->free_list = object;
+            moved++;
+        }
+        pool->global_free_count -= moved;
+        cache->free_count += moved;
+        pthread_mutex_unlock(&pool->mutex);
+        return;
+    }
+
+    // Lista global vazia: cria um slab com vários objetos de uma vez.
+    char *slab = malloc(pool->object_size * OBJECT_POOL_SLAB_OBJECTS);
+    if (slab != NULL)
+    {
+        pool->slab_count++;
+        pool->objects_created += OBJECT_POOL_SLAB_OBJECTS;
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    if (slab == NULL)
+        return;
+
+    for (int i = OBJECT_POOL_SLAB_OBJECTS - 1; i >= 0; i--)
+    {
+        FreeObject *object = (FreeObject *)(slab + (size_t)i * pool->object_size);
+        object->next = cache->free_list;
+        cache->free_list = object;
+    }
+    cache->free_count += OBJECT_POOL_SLAB_OBJECTS;
+}
+
+// Devolve metade do cache da thread para a lista global.
+static void flush_thread_cache(ObjectPool *pool, ThreadCache *cache)
+{
+    FreeObject *batch_head = cache->free_list;
+    FreeObject *batch_tail = batch_head;
+    for (int i = 1; i < THREAD_CACHE_BATCH; i++)
+    {
+        batch_tail = batch_tail->next;
+    }
+    cache->free_list = batch_tail->next;
+    cache->free_count -= THREAD_CACHE_BATCH;
+
+    pthread_mutex_lock(&pool->mutex);
+    batch_tail->next = (FreeObject *)pool->global_free_list;
+    pool->global_free_list = batch_head;
+    pool->global_free_count += THREAD_CACHE_BATCH;
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// Sem cache da thread (registro de pools cheio ou falta de memória): atende direto
+// pela lista global, criando um slab nela quando estiver vazia.
+static void *alloc_from_global_list(ObjectPool *pool)
+{
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->global_free_list == NULL)
+    {
+        char *slab = malloc(pool->object_size * OBJECT_POOL_SLAB_OBJECTS);
+        if (slab == NULL)
+        {
+            pthread_mutex_unlock(&pool->mutex);
+            return NULL;
+        }
+        pool->slab_count++;
+        pool->objects_created += OBJECT_POOL_SLAB_OBJECTS;
+        for (int i = OBJECT_POOL_SLAB_OBJECTS - 1; i >= 0; i--)
+        {
+            FreeObject *object = (FreeObject *)(slab + (size_t)i * pool->object_size);
+            object->next = (FreeObject *)pool->global_free_list;
+            pool->global_free_list = object;
+        }
+        pool->global_free_count += OBJECT_POOL_SLAB_OBJECTS;
+    }
+    FreeObject *object = (FreeObject *)pool->global_free_list;
+    pool->global_free_list = object->next;
+    pool->global_free_count--;
+    pthread_mutex_unlock(&pool->mutex);
+    return object;
+}
+
+// Devolve um objeto direto à lista global, para quando a thread não tem cache.
+static void free_to_global_list(ObjectPool *pool, FreeObject *object)
+{
+    pthread_mutex_lock(&pool->mutex);
+    object->next = (FreeObject *)pool->global_free_list;
+    pool->global_free_list = object;
+    pool->global_free_count++;
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+void *object_pool_alloc(ObjectPool *pool)
+{
+    ThreadCache *cache = get_thread_cache(pool);
+    if (cache == NULL)
+        return alloc_from_global_list(pool);
+
+    __atomic_store_n(&cache->allocations, cache->allocations + 1, __ATOMIC_RELAXED);
+    if (cache->free_list != NULL)
+    {
+        __atomic_store_n(&cache->cache_hits, cache->cache_hits + 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        refill_thread_cache(pool, cache);
+        if (cache->free_list == NULL)
+            return NULL; // Falta de memória
+    }
+
+    FreeObject *object = cache->free_list;
+    cache->free_list = object->next;
+    cache->free_count--;
+    return object;
+}
+
+void object_pool_free(ObjectPool *pool, void *object)
+{
+    if (object == NULL)
+        return;
+    FreeObject *free_object = (FreeObject *)object;
+    ThreadCache *cache = get_thread_cache(pool);
+    if (cache == NULL)
+    {
+        free_to_global_list(pool, free_object);
+        return;
+    }
+
+    free_object->next = cache->free_list;
+    cache->free_list = free_object;
+    cache->free_count++;
+    if (cache->free_count > THREAD_CACHE_MAX_OBJECTS)
+    {
+        flush_thread_cache(pool, cache);
+    }
+}
+
+void object_pool_get_stats(ObjectPool *pool, ObjectPoolStats *stats)
+{
+    memset(stats, 0, sizeof(ObjectPoolStats));
+    stats->name = pool->name;
+    int pool_id = __atomic_load_n(&pool->pool_id, __ATOMIC_ACQUIRE);
+    if (pool_id < 0)
+        return; // Pool nunca usado
+
+    pthread_mutex_lock(&registry_mutex);
+    for (ThreadCacheSet *set = registered_cache_sets; set != NULL; set = set->next_set)
+    {
+        stats->allocations += __atomic_load_n(&set->caches[pool_id].allocations, __ATOMIC_RELAXED);
+        stats->cache_hits += __atomic_load_n(&set->caches[pool_id].cache_hits, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&registry_mutex);
+
+    pthread_mutex_lock(&pool->mutex);
+    stats->malloc_calls = pool->slab_count;
+    stats->objects_created = pool->objects_created;
+    pthread_mutex_unlock(&pool->mutex);
+    stats->mallocs_avoided = stats->allocations - stats->malloc_calls;
+}
+
+void object_pool_print_all_stats(FILE *output)
+{
+    pthread_mutex_lock(&registry_mutex);
+    int pool_count = registered_pool_count;
+    pthread_mutex_unlock(&registry_mutex);
+
+    for (int i = 0; i < pool_count; i++)
+    {
+        ObjectPoolStats stats;
+        object_pool_get_stats(registered_pools[i], &stats);
+        fprintf(output, "Pool %-12s: %lld alocacoes, %lld do cache da thread, %lld mallocs (%lld evitados)\n",
+                stats.name, stats.allocations, stats.cache_hits, stats.malloc_calls, stats.mallocs_avoided);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Pool de objetos de tamanho fixo com cache por thread.
+//
+// Cada thread mantém uma pequena lista de objetos livres por pool; alocar e
+// liberar normalmente não tocam em travas nem no malloc. Quando o cache da
+// thread esvazia (ou enche), objetos são trocados em lote com a lista global do
+// pool, protegida por mutex. Novos objetos são criados em blocos (slabs) de
+// vários objetos por chamada de malloc. A memória nunca volta ao sistema.
+
+#define OBJECT_POOL_MAX_POOLS 16 // Quantidade máxima de pools no programa
+
+typedef struct ObjectPool_t
+{
+    const char *name;          // Nome exibido nas estatísticas
+    size_t object_size;        // Tamanho de cada objeto, em bytes
+    int pool_id;               // Índice do pool no cache das threads (-1 até o primeiro uso)
+    pthread_mutex_t mutex;     // Protege a lista global e os contadores abaixo
+    void *global_free_list;    // Objetos livres devolvidos pelos caches das threads
+    int global_free_count;     // Quantidade de objetos na lista global
+    long long slab_count;      // Chamadas de malloc feitas pelo pool
+    long long objects_created; // Objetos criados no total
+} ObjectPool;
+
+// Inicializador estático: os pools podem ser variáveis globais, sem função de inicialização.
+#define OBJECT_POOL_INITIALIZER(pool_name, size) \
+    {(pool_name), (size), -1, PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0, 0}
+
+// Estatísticas de uso de um pool.
+typedef struct
+{
+    const char *name;
+    long long allocations;        // Objetos pedidos ao pool
+    long long cache_hits;         // Pedidos atendidos direto pelo cache da thread
+    long long malloc_calls;       // Chamadas reais de malloc
+    long long mallocs_avoided;    // allocations - malloc_calls
+    long long objects_created;    // Objetos criados (memória total = objects_created * object_size)
+} ObjectPoolStats;
+
+/* ---------- Operações do Pool ---------- */
+
+// Retorna um objeto não inicializado do pool (NULL se faltar memória).
+void *object_pool_alloc(ObjectPool *pool);
+
+// Devolve ao pool um objeto obtido com object_pool_alloc.
+void object_pool_free(ObjectPool *pool, void *object);
+
+// Preenche 'stats' com as estatísticas atuais do pool.
+void object_pool_get_stats(ObjectPool *pool, ObjectPoolStats *stats);
+
+// Imprime as estatísticas de todos os pools já usados.
+void object_pool_print_all_stats(FILE *output);
+
+#endif // OBJECT_POOL_H
@@ -0,0 +1,260 @@
+#include "rbtree.h"
+
+// Nós ausentes (NULL) são pretos.
+static int is_red(const RbNode *node)
+{
+    return node != NULL && node->is_red;
+}
+
+// Coloca 'replacement' no lugar de 'node' sob o pai de 'node'.
+static void replace_child(RbTree *tree, RbNode *node, RbNode *replacement)
+{
+    if (node->parent == NULL)
+        tree->root = replacement;
+    else if (node->parent->left == node)
+        node->parent->left = replacement;
+    else
+        node->parent->right = replacement;
+    if (replacement != NULL)
+        replacement->parent = node->parent;
+}
+
+static void rotate_left(RbTree *tree, RbNode *node)
+{
+    RbNode *pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left != NULL)
+        pivot->left->parent = node;
+    replace_child(tree, node, pivot);
+    pivot->left = node;
+    node->parent = pivot;
+}
+
+static void rotate_right(RbTree *tree, RbNode *node)
+{
+    RbNode *pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right != NULL)
+        pivot->right->parent = node;
+    replace_child(tree, node, pivot);
+    pivot->right = node;
+    node->parent = pivot;
+}
+
+void rbtree_init(RbTree *tree, int (*compare)(const RbNode *, const RbNode *))
+{
+    tree->root = NULL;
+    tree->leftmost = NULL;
+    tree->size = 0;
+    tree->compare = compare;
+}
+
+void rbtree_insert(RbTree *tree, RbNode *node)
+{
+    // Descida de busca comum até a folha
+    RbNode *parent = NULL;
+    RbNode **link = &tree->root;
+    int is_leftmost = 1;
+    while (*link != NULL)
+    {
+        parent = *link;
+        if (tree->compare(node, parent) < 0)
+        {
+            link = &parent->left;
+        }
+        else
+        {
+            link = &parent->right;
+            is_leftmost = 0;
+        }
+    }
+    node->parent = parent;
+    node->left = NULL;
+    node->right = NULL;
+    node->is_red = 1;
+    *link = node;
+    if (is_leftmost)
+        tree->leftmost = node;
+    tree->size++;
+
+    // Corrige violações de dois vermelhos seguidos, subindo pela árvore
+    while (is_red(node->parent))
+    {
+        RbNode *parent_node = node->parent;
+        RbNode *grandparent = parent_node->parent;
+        if (parent_node == grandparent->left)
+        {
+            RbNode *uncle = grandparent->right;
+            if (is_red(uncle))
+            {
+                parent_node->is_red = 0;
+                uncle->is_red = 0;
+                grandparent->is_red = 1;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent_node->right)
+            {
+                rotate_left(tree, parent_node);
+                node = parent_node;
+                parent_node = node->parent;
+            }
+            parent_node->is_red = 0;
+            grandparent->is_red = 1;
+            rotate_right(tree, grandparent);
+        }
+        else
+        {
+            RbNode *uncle = grandparent->left;
+            if (is_red(uncle))
+            {
+                parent_node->is_red = 0;
+                uncle->is_red = 0;
+                grandparent->is_red = 1;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent_node->left)
+            {
+                rotate_right(tree, parent_node);
+                node = parent_node;
+                parent_node = node->parent;
+            }
+            parent_node->is_red = 0;
+            grandparent->is_red = 1;
+            rotate_left(tree, grandparent);
+        }
+    }
+    tree->root->is_red = 0;
+}
+
+RbNode *rbtree_first(const RbTree *tree)
+{
+    return tree->leftmost;
+}
+
+RbNode *rbtree_next(const RbNode *node)
+{
+    if (node->right != NULL)
+    {
+        node = node->right;
+        while (node->left != NULL)
+            node = node->left;
+        return (RbNode *)node;
+    }
+    while (node->parent != NULL && node == node->parent->right)
+        node = node->parent;
+    return node->parent;
+}
+
+void rbtree_remove(RbTree *tree, RbNode *node)
+{
+    if (tree->leftmost == node)
+        tree->leftmost = rbtree_next(node);
+    tree->size--;
+
+    // 'child' ocupa o lugar do nó retirado da estrutura; 'parent' é seu pai (child pode ser NULL).
+    RbNode *child;
+    RbNode *parent;
+    int removed_red;
+    if (node->left == NULL || node->right == NULL)
+    {
+        child = node->left != NULL ? node->left : node->right;
+        parent = node->parent;
+        removed_red = node->is_red;
+        replace_child(tree, node, child);
+    }
+    else
+    {
+        // Dois filhos: o sucessor (menor da subárvore direita) assume a posição do nó.
+        RbNode *successor = node->right;
+        while (successor->left != NULL)
+            successor = successor->left;
+        removed_red = successor->is_red;
+        child = successor->right;
+        if (successor->parent == node)
+        {
+            parent = successor;
+        }
+        else
+        {
+            parent = successor->parent;
+            replace_child(tree, successor, child);
+            successor->right = node->right;
+            successor->right->parent = successor;
+        }
+        replace_child(tree, node, successor);
+        successor->left = node->left;
+        successor->left->parent = successor;
+        successor->is_red = node->is_red;
+    }
+    if (removed_red)
+        return;
+
+    // Um nó preto saiu: restaura a altura preta a partir de 'child'
+    while (child != tree->root && !is_red(child))
+    {
+        if (child == parent->left)
+        {
+            RbNode *sibling = parent->right;
+            if (is_red(sibling))
+            {
+                sibling->is_red = 0;
+                parent->is_red = 1;
+                rotate_left(tree, parent);
+                sibling = parent->right;
+            }
+            if (!is_red(sibling->left) && !is_red(sibling->right))
+            {
+                sibling->is_red = 1;
+                child = parent;
+                parent = child->parent;
+                continue;
+            }
+            if (!is_red(sibling->right))
+            {
+                sibling->left->is_red = 0;
+                sibling->is_red = 1;
+                rotate_right(tree, sibling);
+                sibling = parent->right;
+            }
+            sibling->is_red = parent->is_red;
+            parent->is_red = 0;
+            sibling->right->is_red = 0;
+            rotate_left(tree, parent);
+            child = tree->root;
+        }
+        else
+        {
+            RbNode *sibling = parent->left;
+            if (is_red(sibling))
+            {
+                sibling->is_red = 0;
+                parent->is_red = 1;
+                rotate_right(tree, parent);
+                sibling = parent->left;
+            }
+            if (!is_red(sibling->left) && !is_red(sibling->right))
+            {
+                sibling->is_red = 1;
+                child = parent;
+                parent = child->parent;
+                continue;
+            }
+            if (!is_red(sibling->left))
+            {
+                sibling->right->is_red = 0;
+                sibling->is_red = 1;
+                rotate_left(tree, sibling);
+                sibling = parent->left;
+            }
+            sibling->is_red = parent->is_red;
+            parent->is_red = 0;
+            sibling->left->is_red = 0;
+            rotate_right(tree, parent);
+            child = tree->root;
+        }
+    }
+    if (child != NULL)
+        child->is_red = 0;
+}
@@ -0,0 +1,47 @@
+#ifndef RBTREE_H
+#define RBTREE_H
+
+// Árvore rubro-negra intrusiva. Cada elemento embute um RbNode e a ordem é
+// definida por uma função de comparação entre nós (negativo se a < b); chaves
+// iguais não são permitidas. O menor nó fica em cache, então consultá-lo custa
+// O(1); inserção e remoção custam O(log n) e não alocam memória.
+// Para recuperar o elemento a partir do nó, use RBTREE_ENTRY.
+
+#include <stddef.h>
+
+#define RBTREE_ENTRY(node, type, member) ((type *)((char *)(node) - offsetof(type, member)))
+
+typedef struct RbNode_t
+{
+    struct RbNode_t *parent; // Pai (NULL na raiz)
+    struct RbNode_t *left;   // Filho com chave menor
+    struct RbNode_t *right;  // Filho com chave maior
+    int is_red;              // Cor do nó
+} RbNode;
+
+typedef struct RbTree_t
+{
+    RbNode *root;                                        // Raiz (NULL se vazia)
+    RbNode *leftmost;                                    // Menor nó (NULL se vazia)
+    int size;                                            // Quantidade de nós
+    int (*compare)(const RbNode *, const RbNode *);      // Função de comparação entre nós
+} RbTree;
+
+/* ---------- Operações da Árvore ---------- */
+
+// Inicializa uma árvore vazia ordenada pela função informada.
+void rbtree_init(RbTree *tree, int (*compare)(const RbNode *, const RbNode *));
+
+// Insere um nó que ainda não está na árvore.
+void rbtree_insert(RbTree *tree, RbNode *node);
+
+// Remove um nó que está na árvore.
+void rbtree_remove(RbTree *tree, RbNode *node);
+
+// Retorna o menor nó, ou NULL se a árvore estiver vazia.
+RbNode *rbtree_first(const RbTree *tree);
+
+// Retorna o nó seguinte na ordem, ou NULL se 'node' for o maior.
+RbNode *rbtree_next(const RbNode *node);
+
+#endif // RBTREE_H
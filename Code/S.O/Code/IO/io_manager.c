@@ -1,12 +1,14 @@
 #include "io_manager.h"
 #include "../Nucleo/kernel.h"
 #include "../Ferramentas/list.h"
+#include "../Ferramentas/object_pool.h"
 #include <pthread.h> // Para threads (pthreads)
 #include <stdlib.h>  // Para funções padrão como malloc, free, abs
 #include <unistd.h>  // Para a função usleep (não utilizada neste arquivo, mas comum em I/O)
 #include <limits.h>  // Para constantes como INT_MAX (usado no algoritmo SSTF)
 #include <stdio.h>   // Para funções de entrada/saída padrão
 #include "../Clock/clock.h" // Para agendar eventos futuros
+#include "../Nucleo/thread_stats.h" // Para contabilizar o tempo de CPU das threads de I/O
 
 // Estrutura interna, específica deste módulo, para representar um pedido de I/O.
 // Ela encapsula o processo que fez a requisição e um valor genérico.
@@ -16,6 +18,9 @@ typedef struct
     int value;    // Para disco: representa o número da trilha. Para impressora: o tempo de impressão.
 } IORequest;
 
+// Pool dos pedidos de I/O: alocados pelos handlers do kernel e liberados pelas threads de I/O.
+static ObjectPool io_request_pool = OBJECT_POOL_INITIALIZER("IORequest", sizeof(IORequest));
+
 // -----------------------------------------------------------------------------
 // Variáveis estáticas do módulo: filas, posição do disco e mecanismos de sincronização.
 // 'static' significa que estas variáveis só são visíveis dentro deste arquivo.
@@ -77,9 +82,10 @@ void IOManager__initialize()
 void IOManager__add_disk_request(Bcp *process, int track)
 {
     // Cria um novo pedido de disco.
-    IORequest *req = malloc(sizeof(IORequest));
+    IORequest *req = object_pool_alloc(&io_request_pool);
     req->process = process;
     req->value = track;
+    Clock__begin_activity(); // O pedido é trabalho do instante atual até seu término ser agendado
 
     // Trava o mutex para adicionar o pedido à fila de forma segura.
     pthread_mutex_lock(&disk_mutex);
@@ -98,9 +104,10 @@ void IOManager__add_disk_request(Bcp *process, int track)
 void IOManager__add_printer_request(Bcp *process, int print_time)
 {
     // Cria um novo pedido de impressão.
-    IORequest *req = malloc(sizeof(IORequest));
+    IORequest *req = object_pool_alloc(&io_request_pool);
     req->process = process;
     req->value = print_time;
+    Clock__begin_activity();
 
     // Trava o mutex para adicionar o pedido à fila de forma segura.
     pthread_mutex_lock(&printer_mutex);
@@ -116,6 +123,7 @@ void IOManager__add_printer_request(Bcp *process, int print_time)
  */
 void *process_disk_queue_thread(void *args)
 {
+    ThreadStats__register_current(SUBSYSTEM_IO);
     while (1) // Loop eterno da thread.
     {
         // Trava o mutex para acessar a fila.
@@ -154,9 +162,10 @@ void *process_disk_queue_thread(void *args)
         current_disk_head_position = chosen_req->value; // Atualiza a posição da cabeça.
         // Agenda um evento no clock para sinalizar o fim da operação de I/O após um tempo fixo.
         Clock__schedule_event(4000, EVT_DISK_FINISH, chosen_req->process);
+        Clock__end_activity();
 
-        // Libera a memória da estrutura da requisição.
-        free(chosen_req);
+        // Devolve a estrutura da requisição ao pool.
+        object_pool_free(&io_request_pool, chosen_req);
     }
     return NULL;
 }
@@ -167,6 +176,7 @@ void *process_disk_queue_thread(void *args)
  */
 void *process_printer_queue_thread(void *args)
 {
+    ThreadStats__register_current(SUBSYSTEM_IO);
     while (1) // Loop eterno da thread.
     {
         // Trava o mutex para acessar a fila.
@@ -189,9 +199,10 @@ void *process_printer_queue_thread(void *args)
         // Agenda um evento no clock para sinalizar o fim da impressão.
         // O tempo de impressão é variável, definido pelo próprio processo.
         Clock__schedule_event(req_to_process->value, EVT_PRINT_FINISH, req_to_process->process);
+        Clock__end_activity();
 
-        // Libera a memória da estrutura da requisição.
-        free(req_to_process);
+        // Devolve a estrutura da requisição ao pool.
+        object_pool_free(&io_request_pool, req_to_process);
     }
     return NULL;
 }
@@ -0,0 +1,315 @@
+#include "headless.h"
+#include "../Nucleo/kernel.h"
+#include "../Nucleo/common_structs.h"
+#include "../Clock/clock.h"
+#include "../Clock/timescale.h"
+#include "../CPU/cpu.h"
+#include "../escalonador/scheduler.h"
+#include "../Nucleo/config.h"
+#include "../Nucleo/trace.h"
+#include "../Nucleo/metrics.h"
+#include "../Ferramentas/object_pool.h"
+#include "../Process/program.h"
+#include <stdio.h>    // Para impressão do resumo
+#include <stdlib.h>   // Para malloc, free
+#include <string.h>   // Para manipulação de strings
+#include <pthread.h>  // Para a thread do kernel
+#include <dirent.h>   // Para percorrer diretórios de arquivos .synt
+#include <sys/stat.h> // Para distinguir arquivos de diretórios
+#include <time.h>     // Para medir o tempo real (wall time)
+#include <errno.h>    // Para detectar estouro em strtol
+#include <limits.h>   // Para INT_MAX
+
+// Intervalo entre as verificações de progresso da simulação (ver Kernel__wait_for_terminations).
+#define HEADLESS_STALL_TIMEOUT_MS 1000
+
+// -----------------------------------------------------------------------------
+// Funções auxiliares para montar a lista de arquivos da carga de trabalho.
+// -----------------------------------------------------------------------------
+
+// Arquivo da carga de trabalho e quantos processos criar a partir dele
+typedef struct
+{
+    char *path; // Caminho (alocado com malloc; o kernel assume a posse)
+    int copies; // Processos a criar (mais de um: modelo + cópias, ver --spawn)
+} WorkloadEntry;
+
+static void add_workload_entry(List *workload, char *path, int copies)
+{
+    WorkloadEntry *entry = malloc(sizeof(WorkloadEntry));
+    entry->path = path;
+    entry->copies = copies;
+    add_to_list(workload, entry);
+}
+
+// Lê a quantidade de cópias de --spawn: o argumento inteiro precisa ser um número
+// positivo que caiba em um int. Retorna -1 se for inválido.
+static int parse_copy_count(const char *text)
+{
+    char *end_ptr;
+    errno = 0;
+    long value = strtol(text, &end_ptr, 10);
+    if (end_ptr == text || *end_ptr != '\0' || errno == ERANGE || value <= 0 || value > INT_MAX)
+        return -1;
+    return (int)value;
+}
+
+// Ignora entradas ocultas e os diretórios especiais "." e "..".
+static int is_visible_entry(const struct dirent *entry)
+{
+    return entry->d_name[0] != '.';
+}
+
+// Adiciona à lista todos os arquivos regulares de um diretório, em ordem alfabética
+// (a ordem fixa garante que os PIDs sejam atribuídos sempre da mesma forma).
+static void collect_directory_files(const char *dir_path, List *file_paths)
+{
+    struct dirent **entries;
+    int entry_count = scandir(dir_path, &entries, is_visible_entry, alphasort);
+    if (entry_count < 0)
+    {
+        fprintf(stderr, "headless: nao foi possivel abrir o diretorio '%s'.\n", dir_path);
+        return;
+    }
+
+    size_t dir_len = strlen(dir_path);
+    int needs_separator = (dir_len > 0 && dir_path[dir_len - 1] != '/');
+    for (int i = 0; i < entry_count; i++)
+    {
+        char *file_path = malloc(dir_len + strlen(entries[i]->d_name) + 2);
+        if (file_path)
+        {
+            sprintf(file_path, "%s%s%s", dir_path, needs_separator ? "/" : "", entries[i]->d_name);
+            struct stat file_info;
+            if (stat(file_path, &file_info) == 0 && S_ISREG(file_info.st_mode))
+            {
+                add_workload_entry(file_paths, file_path, 1);
+            }
+            else
+            {
+                free(file_path);
+            }
+        }
+        free(entries[i]);
+    }
+    free(entries);
+}
+
+// Converte um par de instantes reais em segundos.
+static double elapsed_seconds(const struct timespec *start, const struct timespec *end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void print_usage()
+{
+    fprintf(stderr, "Uso: icarus_sim --headless [opcoes] <arquivo.synt | diretorio | --spawn <n> <arquivo>> [...]\n");
+    fprintf(stderr, "Opcoes:\n");
+    Config__print_usage(stderr);
+    fprintf(stderr, "  --spawn <n> <arquivo>  Cria n processos do arquivo, copiando o primeiro (sem reler o arquivo)\n");
+}
+
+// -----------------------------------------------------------------------------
+// Execução de uma carga de trabalho, sem impressão de resultados.
+// -----------------------------------------------------------------------------
+void Headless__simulate(char **paths, const int *copies, int path_count, HeadlessReport *report)
+{
+    struct timespec wall_start, wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    Kernel__initialize();
+    pthread_t kernel_thread;
+    pthread_create(&kernel_thread, NULL, (void *(*)(void *))Kernel__run_simulation, NULL);
+    pthread_detach(kernel_thread);
+
+    // Dispara a criação de todos os processos em um único lote: o clock não vê a carga
+    // pela metade, mesmo no modo determinístico. Arquivos com várias cópias viram um
+    // único evento de spawn.
+    EventDispatch *create_events = malloc(sizeof(EventDispatch) * path_count);
+    int event_count = 0;
+    int process_count = 0;
+    int undispatched_count = 0; // Processos cujo pedido de criação não pôde ser montado
+    for (int i = 0; i < path_count; i++)
+    {
+        int copy_count = copies ? copies[i] : 1;
+        process_count += copy_count;
+        if (copy_count == 1)
+        {
+            create_events[event_count].type = EVT_PROCESS_CREATE;
+            create_events[event_count++].data = paths[i];
+        }
+        else
+        {
+            SpawnArgs *spawn_args = malloc(sizeof(SpawnArgs));
+            if (spawn_args == NULL)
+            {
+                fprintf(stderr, "headless: memoria insuficiente para criar as copias de '%s'.\n", paths[i]);
+                free(paths[i]);
+                undispatched_count += copy_count;
+                continue;
+            }
+            spawn_args->file_path = paths[i];
+            spawn_args->count = copy_count;
+            create_events[event_count].type = EVT_PROCESS_SPAWN;
+            create_events[event_count++].data = spawn_args;
+        }
+    }
+    Kernel__dispatch_events_batch(create_events, event_count);
+    free(create_events);
+
+    // Aguarda até que todos os processos tenham terminado, ou que a simulação pare
+    // de progredir (ex: deadlock entre processos que disputam semáforos).
+    Kernel__wait_for_terminations(process_count - undispatched_count, HEADLESS_STALL_TIMEOUT_MS);
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+    report->process_count = process_count;
+    pthread_mutex_lock(&process_table_mutex);
+    report->terminated_count = kernel_instance->terminated_process_count;
+    report->failed_count = kernel_instance->failed_process_count + undispatched_count;
+    pthread_mutex_unlock(&process_table_mutex);
+    report->wall_seconds = elapsed_seconds(&wall_start, &wall_end);
+    report->virtual_time = Clock__get_time();
+    report->dispatched_events = __atomic_load_n(&kernel_instance->dispatched_event_count, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&kernel_instance->scheduler->ready_queue_mutex);
+    report->context_switches = kernel_instance->scheduler->context_switch_count;
+    report->steal_count = kernel_instance->scheduler->steal_count;
+    report->schedule_digest = kernel_instance->scheduler->schedule_digest;
+    pthread_mutex_unlock(&kernel_instance->scheduler->ready_queue_mutex);
+    report->scheduler_seconds =
+        __atomic_load_n(&kernel_instance->scheduler->context_switch_ns, __ATOMIC_RELAXED) / 1e9;
+}
+
+// -----------------------------------------------------------------------------
+// Ponto de entrada do modo headless.
+// -----------------------------------------------------------------------------
+int Headless__run(int argc, char *argv[])
+{
+    List *file_paths = create_list();
+
+    // Sem interface não há o que visualizar: por padrão a simulação roda sem pausas.
+    // Uma opção --timescale explícita, lida abaixo, tem precedência.
+    Timescale__configure("afap");
+    kernel_config.echo_errors_to_stderr = 1; // O log do kernel não é exibido sem interface
+
+    // Cada argumento pode ser uma opção do núcleo, um arquivo .synt, um diretório de
+    // arquivos ou um pedido de cópias (--spawn).
+    for (int i = 0; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--spawn") == 0)
+        {
+            struct stat spawn_info;
+            int copy_count = (i + 2 < argc) ? parse_copy_count(argv[i + 1]) : 0;
+            if (copy_count <= 0)
+            {
+                fprintf(stderr, "headless: uso de --spawn: --spawn <n> <arquivo> (n inteiro positivo).\n");
+                print_usage();
+                return 1;
+            }
+            // Ao contrário de um caminho avulso, o arquivo de --spawn é obrigatório: sem ele
+            // a carga pedida (n processos) não existe.
+            if (stat(argv[i + 2], &spawn_info) != 0 || !S_ISREG(spawn_info.st_mode))
+            {
+                fprintf(stderr, "headless: arquivo '%s' de --spawn nao encontrado.\n", argv[i + 2]);
+                return 1;
+            }
+            add_workload_entry(file_paths, strdup(argv[i + 2]), copy_count);
+            i += 2;
+            continue;
+        }
+        if (strncmp(argv[i], "--", 2) == 0)
+        {
+            if (Config__parse_option(argc, argv, &i) <= 0)
+            {
+                fprintf(stderr, "headless: opcao invalida '%s'.\n", argv[i]);
+                print_usage();
+                return 1;
+            }
+            continue;
+        }
+
+        struct stat path_info;
+        if (stat(argv[i], &path_info) != 0)
+        {
+            fprintf(stderr, "headless: caminho '%s' nao encontrado.\n", argv[i]);
+            continue;
+        }
+        if (S_ISDIR(path_info.st_mode))
+        {
+            collect_directory_files(argv[i], file_paths);
+        }
+        else
+        {
+            add_workload_entry(file_paths, strdup(argv[i]), 1);
+        }
+    }
+
+    if (file_paths->size == 0)
+    {
+        print_usage();
+        destroy_list(file_paths);
+        return 1;
+    }
+
+    // O kernel assume a posse dos caminhos.
+    int path_count = file_paths->size;
+    char **paths = malloc(sizeof(char *) * path_count);
+    int *copies = malloc(sizeof(int) * path_count);
+    Node *path_node = file_paths->head;
+    for (int i = 0; i < path_count; i++)
+    {
+        WorkloadEntry *entry = (WorkloadEntry *)path_node->data;
+        paths[i] = entry->path;
+        copies[i] = entry->copies;
+        free(entry);
+        path_node = path_node->next;
+    }
+    destroy_list(file_paths);
+
+    HeadlessReport report;
+    Headless__simulate(paths, copies, path_count, &report);
+    free(paths);
+    free(copies);
+
+    // Resumo final da simulação.
+    printf("==> Resumo da simulacao (headless)\n");
+    printf("Processos.............: %d\n", report.process_count);
+    if (report.failed_count > 0)
+        printf("Falhas ao carregar....: %d\n", report.failed_count);
+    printf("Tempo virtual final...: %lld\n", report.virtual_time);
+    printf("Tempo real (s)........: %.6f\n", report.wall_seconds);
+    printf("Eventos despachados...: %lld\n", report.dispatched_events);
+    printf("Trocas de contexto....: %lld\n", report.context_switches);
+    printf("Tempo no escalonador..: %.6f s\n", report.scheduler_seconds);
+    printf("Workers de eventos....: %d\n", Config__get_handler_worker_count());
+    printf("Modo deterministico...: %s\n", kernel_config.deterministic ? "sim" : "nao");
+    if (kernel_config.quantum > 0)
+        printf("Escalonamento.........: %s (quantum %d)\n", kernel_config.sched_policy, kernel_config.quantum);
+    else
+        printf("Escalonamento.........: %s\n", kernel_config.sched_policy);
+    printf("Nucleos de CPU........: %d (roubos de trabalho: %lld)\n", kernel_config.cpu_core_count,
+           report.steal_count);
+    printf("Digest do escalonamento: %016llx\n", report.schedule_digest);
+    printf("Eventos/s.............: %.0f\n",
+           report.wall_seconds > 0 ? report.dispatched_events / report.wall_seconds : 0.0);
+    Metrics__print(stdout);
+    object_pool_print_all_stats(stdout);
+    Program__print_cache_stats(stdout);
+    if (Trace__is_enabled())
+    {
+        Trace__dump(stdout);
+    }
+
+    int stalled_count = report.process_count - report.terminated_count - report.failed_count;
+    if (stalled_count > 0)
+    {
+        printf("AVISO: simulacao parada com %d processo(s) sem terminar (possivel deadlock).\n", stalled_count);
+        return 2;
+    }
+    if (report.failed_count > 0)
+    {
+        printf("ERRO: %d processo(s) nao puderam ser carregados.\n", report.failed_count);
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#ifndef HEADLESS_H_GUARD
+#define HEADLESS_H_GUARD
+
+/**
+ * @brief Resultado de uma execução headless.
+ */
+typedef struct
+{
+    int process_count;                  // Processos enviados ao kernel
+    int terminated_count;               // Processos finalizados
+    int failed_count;                   // Processos que não puderam ser criados (ex: arquivo inválido)
+    long long virtual_time;             // Tempo virtual ao final
+    double wall_seconds;                // Tempo real da execução
+    long long dispatched_events;        // Eventos despachados ao kernel
+    long long context_switches;         // Eleições do escalonador
+    long long steal_count;              // Processos roubados da fila de outro núcleo da CPU
+    double scheduler_seconds;           // Tempo real gasto em trocas de contexto
+    unsigned long long schedule_digest; // Digest do escalonamento (ver scheduler.h)
+} HeadlessReport;
+
+/**
+ * @brief Inicializa o kernel, carrega os arquivos informados e espera até que todos
+ * os processos terminem (ou que a simulação pare de progredir).
+ *
+ * Só pode ser chamada uma vez por processo, pois o kernel e suas threads são únicos.
+ * O kernel assume a posse das strings em 'paths' (os vetores continuam do chamador).
+ *
+ * @param paths      Caminhos dos arquivos .synt (alocados com malloc); podem se repetir.
+ * @param copies     Processos a criar de cada arquivo (as cópias compartilham o programa,
+ *                   ver Process__spawn), ou NULL para um processo por caminho.
+ * @param path_count Quantidade de caminhos.
+ * @param report     Recebe as métricas da execução.
+ */
+void Headless__simulate(char **paths, const int *copies, int path_count, HeadlessReport *report);
+
+/**
+ * @brief Executa a simulação sem interface gráfica (modo batch).
+ *
+ * Carrega os arquivos .synt informados (ou todos os arquivos de um diretório),
+ * roda o kernel sem pausas artificiais até que todos os processos terminem e
+ * imprime um resumo final na saída padrão.
+ *
+ * @param argc Quantidade de argumentos após "--headless".
+ * @param argv Caminhos de arquivos ou diretórios a carregar.
+ * @return Código de saída do programa: 0 em caso de sucesso, 2 se a simulação parou
+ *         com processos sem terminar, 3 se algum arquivo não pôde ser carregado.
+ */
+int Headless__run(int argc, char *argv[]);
+
+#endif // HEADLESS_H_GUARD
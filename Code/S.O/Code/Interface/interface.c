@@ -1,9 +1,17 @@
 #include "interface.h"
+#include "headless.h"
 #include "../Nucleo/kernel.h"
+#include "../Nucleo/config.h"
+#include "../Nucleo/trace.h"
+#include "../Nucleo/metrics.h"
 #include "../Clock/clock.h"
+#include "../Clock/timescale.h"
 #include "../IO/io_manager.h"
 #include "../Memoria/Page.h"
 #include "../Semaforo/semaf.h"
+#include "../Nucleo/common_structs.h"
+#include "../escalonador/scheduler.h"
+#include "../CPU/cpu.h"
 #include <ncurses.h> // Biblioteca para a interface gráfica no terminal
 #include <string.h>  // Para manipulação de strings (strlen, strcmp, etc.)
 #include <stdlib.h>  // Para funções padrão (malloc, free, etc.)
@@ -28,12 +36,25 @@ typedef struct
     char state[16]; // Estado atual do processo (ex: PRONTO, EXECUTANDO)
 } ProcessUI;
 
+// Estado de um núcleo da CPU copiado para exibição.
+typedef struct
+{
+    int pid;          // PID do processo em execução (0 = núcleo ocioso)
+    char name[32];    // Nome do processo em execução
+    int ready_count;  // Processos na fila de prontos do núcleo
+} CoreUI;
+
 // Ponteiros globais para as janelas (sub-telas) que o ncurses vai gerenciar.
 WINDOW *header_win, *menu_win, *kernel_win, *memory_win, *process_win, *input_win;
 
+// 1 quando a tabela de processos mostra as métricas de escalonamento (tecla 'M').
+static int show_process_metrics = 0;
+
 // Protótipos de funções que tratam a entrada do usuário.
 void handle_input();
+void handle_spawn_input();
 void handle_load_all_processes();
+void handle_trace_dump();
 
 // -----------------------------------------------------------------------------
 // Funções auxiliares para inicialização de cores e janelas da interface.
@@ -116,6 +137,20 @@ void draw_menu()
     wattroff(menu_win, COLOR_PAIR(2) | A_BOLD); // Desativa a cor e o negrito
     mvwprintw(menu_win, 3, 2, "1. Carregar Proc.");
     mvwprintw(menu_win, 4, 2, "2. Carregar Todos");
+    mvwprintw(menu_win, 5, 2, "3. Clonar Proc.");
+    mvwprintw(menu_win, 6, 2, "+/- Velocidade");
+    mvwprintw(menu_win, 7, 2, "F. Avanco rapido");
+    mvwprintw(menu_win, 8, 2, show_process_metrics ? "M. Tabela de proc." : "M. Metricas");
+    if (Trace__is_enabled())
+    {
+        mvwprintw(menu_win, 9, 2, "T. Latencias");
+    }
+
+    // Escala de tempo atual
+    char timescale_description[32];
+    Timescale__describe(timescale_description, sizeof(timescale_description));
+    mvwprintw(menu_win, 10, 2, "Escala:");
+    mvwprintw(menu_win, 11, 2, "%.16s", timescale_description);
     mvwprintw(menu_win, getmaxy(menu_win) - 2, 2, "Q - Sair");
     wrefresh(menu_win);
 }
@@ -131,12 +166,19 @@ void draw_kernel()
     mvwprintw(kernel_win, 1, 2, "LOG DO ESCALONADOR E EVENTOS");
     wattroff(kernel_win, COLOR_PAIR(3) | A_BOLD);
 
+    // Os núcleos da CPU ocupam as linhas acima das filas de E/S, até metade da janela.
+    int core_count = CPU__get_core_count();
+    int core_lines = core_count < (getmaxy(kernel_win) - 8) / 2 ? core_count : (getmaxy(kernel_win) - 8) / 2;
+    if (core_lines < 0)
+        core_lines = 0;
+    int cores_top = getmaxy(kernel_win) - 4 - core_lines;
+
     // Trava o mutex para ler a lista de logs de forma segura (evitar race condition).
     pthread_mutex_lock(&kernel_instance->scheduler_log_mutex);
     Node *log_node = kernel_instance->scheduler_log->head;
     int line = 3;
     // Itera sobre a lista de logs e imprime cada mensagem.
-    while (log_node != NULL && line < getmaxy(kernel_win) - 4)
+    while (log_node != NULL && line < cores_top)
     { 
         mvwprintw(kernel_win, line, 2, "> %s", (char *)log_node->data);
         log_node = log_node->next;
@@ -144,6 +186,31 @@ void draw_kernel()
     }
     pthread_mutex_unlock(&kernel_instance->scheduler_log_mutex); // Libera o mutex
 
+    // Copia o estado dos núcleos exibidos sob as travas da CPU e das filas de prontos
+    // (nessa ordem, a mesma da troca de contexto) e o exibe depois de liberá-las.
+    CoreUI core_states[CONFIG_MAX_CPU_CORES];
+    Scheduler *scheduler = kernel_instance->scheduler;
+    CPU__lock();
+    pthread_mutex_lock(&scheduler->ready_queue_mutex);
+    for (int core = 0; core < core_lines; core++)
+    {
+        Bcp *running = kernel_instance->running_process[core];
+        core_states[core].pid = running ? running->pid : 0;
+        snprintf(core_states[core].name, sizeof(core_states[core].name), "%s", running ? running->name_str : "");
+        core_states[core].ready_count = scheduler->run_queues[core].ready_count;
+    }
+    pthread_mutex_unlock(&scheduler->ready_queue_mutex);
+    CPU__unlock();
+    for (int core = 0; core < core_lines; core++)
+    {
+        if (core_states[core].pid != 0)
+            mvwprintw(kernel_win, cores_top + core, 2, "CPU %-2d: PID %3d (%-9.9s) | Prontos: %d", core,
+                      core_states[core].pid, core_states[core].name, core_states[core].ready_count);
+        else
+            mvwprintw(kernel_win, cores_top + core, 2, "CPU %-2d: ociosa              | Prontos: %d", core,
+                      core_states[core].ready_count);
+    }
+
     // Exibe o tamanho atual das filas de disco e impressora.
     mvwprintw(kernel_win, getmaxy(kernel_win) - 4, 2, "DISCO (SSTF) Fila: %d", IOManager_get_disk_queue_size());
     mvwprintw(kernel_win, getmaxy(kernel_win) - 3, 2, "IMPRESSORA Fila..: %d", IOManager_get_printer_queue_size());
@@ -206,6 +273,65 @@ void draw_memory()
     wrefresh(memory_win);
 }
 
+/**
+ * @brief Formata um intervalo de tempo virtual, ou "-" se ainda não é conhecido.
+ */
+static const char *format_metric_time(char *buffer, size_t size, long long value)
+{
+    if (value < 0)
+        snprintf(buffer, size, "-");
+    else
+        snprintf(buffer, size, "%lld", value);
+    return buffer;
+}
+
+/**
+ * @brief Desenha as métricas de escalonamento de cada processo (tecla 'M').
+ * Deve ser chamada com process_table_mutex travado.
+ */
+static void draw_process_metrics()
+{
+    int width = getmaxx(process_win) - 4; // Espaço útil entre as bordas; as linhas são cortadas nele
+    char row[160];
+
+    // Resumo do sistema
+    SystemMetrics system;
+    Metrics__get_system(&system);
+    snprintf(row, sizeof(row), "CPU: %.1f%% | Concluidos: %lld | Vazao: %.3f/1000 | Turnaround p50/p99: %lld/%lld",
+             system.cpu_utilization * 100.0, system.completed_count, system.throughput, system.turnaround.p50,
+             system.turnaround.p99);
+    mvwprintw(process_win, 2, 2, "%.*s", width, row);
+    mvwprintw(process_win, 3, 2, "%.*s", width, "PID | Nome      | Pronto | CPU    | E/S    | Sem    | Resp   | Turnaround");
+    mvwprintw(process_win, 4, 2, "%.*s", width, "----+-----------+--------+--------+--------+--------+--------+-----------");
+
+    Bcp *pcb = ProcessTable__first(&kernel_instance->process_table);
+    if (pcb == NULL)
+    {
+        mvwprintw(process_win, 6, 2, "Nenhum processo no sistema.");
+        return;
+    }
+
+    // Tempos acumulados em cada estado; resposta e turnaround só existem depois da
+    // primeira eleição e do término, respectivamente.
+    int line = 5;
+    while (pcb != NULL && line < getmaxy(process_win) - 1)
+    {
+        ProcessMetrics metrics;
+        Metrics__get_process(pcb, &metrics);
+        char response_str[24], turnaround_str[24];
+        format_metric_time(response_str, sizeof(response_str),
+                           metrics.first_run_time >= 0 ? metrics.first_run_time - metrics.arrival_time : -1);
+        format_metric_time(turnaround_str, sizeof(turnaround_str),
+                           metrics.finish_time >= 0 ? metrics.finish_time - metrics.arrival_time : -1);
+        snprintf(row, sizeof(row), "%3d | %-9s | %6lld | %6lld | %6lld | %6lld | %6s | %s", pcb->pid,
+                 pcb->name_str, metrics.ready_time, metrics.cpu_time, metrics.io_wait_time,
+                 metrics.semaphore_wait_time, response_str, turnaround_str);
+        mvwprintw(process_win, line, 2, "%.*s", width, row);
+        pcb = ProcessTable__next(&kernel_instance->process_table, pcb);
+        line++;
+    }
+}
+
 /**
  * @brief Desenha a tabela com todos os processos ativos no sistema.
  */
@@ -216,32 +342,58 @@ void draw_process()
     wattron(process_win, COLOR_PAIR(5) | A_BOLD);
     mvwprintw(process_win, 1, 2, "TABELA DE PROCESSOS (BCP)");
     wattroff(process_win, COLOR_PAIR(5) | A_BOLD);
+    wprintw(process_win, " - Escalonamento: %s", kernel_config.sched_policy);
+
+    // Com a tecla 'M', a tabela mostra as métricas de escalonamento no lugar dos dados do BCP.
+    if (show_process_metrics)
+    {
+        pthread_mutex_lock(&process_table_mutex);
+        draw_process_metrics();
+        pthread_mutex_unlock(&process_table_mutex);
+        wrefresh(process_win);
+        return;
+    }
 
     mvwprintw(process_win, 3, 2, "PID | Nome      | Prio | Seg | Size | I/O | Estado");
     mvwprintw(process_win, 4, 2, "----+-----------+------+-----+------+-----+-----------");
 
-    // Trava o mutex da lista de PCBs para garantir uma leitura consistente.
-    pthread_mutex_lock(&pcb_list_mutex);
-    Node *p_node = kernel_instance->pcb_list->head;
+    // Trava o mutex da tabela de processos para garantir uma leitura consistente.
+    pthread_mutex_lock(&process_table_mutex);
+
+    // Resumo por estado, contado direto na coluna de estados da tabela.
+    int state_counts[PROCESS_STATE_RUNNING + 1];
+    ProcessTable__count_states(&kernel_instance->process_table, state_counts, PROCESS_STATE_RUNNING + 1);
+    mvwprintw(process_win, 2, 2, "Prontos: %d | Esperando: %d | Executando: %d", state_counts[PROCESS_STATE_READY],
+              state_counts[PROCESS_STATE_WAITING], state_counts[PROCESS_STATE_RUNNING]);
+    Bcp *pcb = ProcessTable__first(&kernel_instance->process_table);
     int line = 5;
 
-    // Se a lista de processos estiver vazia, exibe uma mensagem.
-    if (p_node == NULL)
+    // Se a tabela de processos estiver vazia, exibe uma mensagem.
+    if (pcb == NULL)
     {
         mvwprintw(process_win, 6, 2, "Nenhum processo no sistema.");
     }
     else
     {
-        // Itera sobre a lista de processos e imprime os detalhes de cada um.
-        while (p_node != NULL && line < getmaxy(process_win) - 1)
+        // Percorre a tabela na ordem de criação e imprime os detalhes de cada processo.
+        while (pcb != NULL && line < getmaxy(process_win) - 1)
         {
-            Bcp *pcb = (Bcp *)p_node->data;
             const char *state_str;
+            char running_str[24];
             // Converte o enum de estado do processo para uma string legível.
-            switch (pcb->current_execution_state)
+            switch (Process__get_state(pcb))
             {
             case PROCESS_STATE_RUNNING:
-                state_str = "EXECUTANDO";
+                // Com mais de um núcleo, mostra também em qual ele executa.
+                if (CPU__get_core_count() > 1)
+                {
+                    snprintf(running_str, sizeof(running_str), "EXECUTANDO (CPU %d)", pcb->cpu_core);
+                    state_str = running_str;
+                }
+                else
+                {
+                    state_str = "EXECUTANDO";
+                }
                 break;
             case PROCESS_STATE_READY:
                 state_str = "PRONTO";
@@ -249,20 +401,23 @@ void draw_process()
             case PROCESS_STATE_WAITING:
                 state_str = "ESPERANDO";
                 break;
+            case PROCESS_STATE_TERMINATED:
+                state_str = "TERMINADO";
+                break;
             default:
                 state_str = "NOVO";
                 break;
             }
             // Imprime a linha formatada com os dados do processo.
             mvwprintw(process_win, line, 2, "%3d | %-9s | %4d | %3d | %4d | %3d | %s",
-                      pcb->pid, pcb->name_str, pcb->priority_level, pcb->segment_identifier,
+                      pcb->pid, pcb->name_str, Process__get_priority(pcb), pcb->segment_identifier,
                       pcb->segment_size_bytes / 1024, pcb->total_read_ops + pcb->total_write_ops, state_str);
-            p_node = p_node->next;
+            pcb = ProcessTable__next(&kernel_instance->process_table, pcb);
             line++;
         }
     }
 
-    pthread_mutex_unlock(&pcb_list_mutex); // Libera o mutex
+    pthread_mutex_unlock(&process_table_mutex); // Libera o mutex
     wrefresh(process_win);
 }
 
@@ -313,6 +468,44 @@ void handle_input()
     }
 }
 
+/**
+ * @brief Lida com a entrada do usuário para criar várias cópias de um processo.
+ */
+void handle_spawn_input()
+{
+    char command[256];
+
+    wattron(input_win, COLOR_PAIR(6) | A_BOLD);
+    mvwprintw(input_win, 1, 11, "Arquivo em 'synt/' e copias (ex: synt1 100), ENTER: ");
+    wattroff(input_win, COLOR_PAIR(6) | A_BOLD);
+    echo();
+    curs_set(1);
+    mvwgetnstr(input_win, 1, 64, command, sizeof(command) - 1);
+    curs_set(0);
+    noecho();
+
+    char filename[200];
+    int copy_count = 0;
+    if (sscanf(command, "%199s %d", filename, &copy_count) == 2 && copy_count > 0)
+    {
+        SpawnArgs *spawn_args = malloc(sizeof(SpawnArgs));
+        spawn_args->file_path = malloc(strlen("synt/") + strlen(filename) + 1);
+        sprintf(spawn_args->file_path, "synt/%s", filename);
+        spawn_args->count = copy_count;
+
+        // Um único evento: o kernel lê o arquivo uma vez e copia o processo modelo.
+        Kernel__dispatch_event(EVT_PROCESS_SPAWN, spawn_args);
+        mvwprintw(input_win, 1, 11, "%d copia(s) de '%s' enviadas ao kernel!                       ", copy_count,
+                  filename);
+    }
+    else
+    {
+        mvwprintw(input_win, 1, 11, "Formato invalido: use <arquivo> <copias>.                        ");
+    }
+    wrefresh(input_win);
+    sleep(1); // Pausa para que a mensagem possa ser lida.
+}
+
 /**
  * @brief Lida com o comando para carregar todos os processos da pasta "synt/".
  */
@@ -323,6 +516,8 @@ void handle_load_all_processes()
     const char *dir_path = "synt/";
     d = opendir(dir_path); // Abre o diretório
     int count = 0;
+    int capacity = 0;
+    EventDispatch *create_events = NULL;
 
     if (d) // Se o diretório foi aberto com sucesso..
     {
@@ -335,20 +530,38 @@ void handle_load_all_processes()
                 continue;
             }
 
+            // Garante espaço no vetor de eventos.
+            if (count == capacity)
+            {
+                int new_capacity = capacity == 0 ? 16 : capacity * 2;
+                EventDispatch *grown = realloc(create_events, sizeof(EventDispatch) * new_capacity);
+                if (!grown)
+                {
+                    break;
+                }
+                create_events = grown;
+                capacity = new_capacity;
+            }
+
             // Aloca memória para o caminho completo do arquivo.
             char *file_path = malloc(strlen(dir_path) + strlen(dir->d_name) + 1);
             if (file_path)
             {
                 sprintf(file_path, "%s%s", dir_path, dir->d_name);
 
-                // Dispara o evento de criação para cada arquivo encontrado.
-                Kernel__dispatch_event(EVT_PROCESS_CREATE, file_path);
+                // Prepara o evento de criação para cada arquivo encontrado.
+                create_events[count].type = EVT_PROCESS_CREATE;
+                create_events[count].data = file_path;
                 count++;
             }
         }
         closedir(d); // Fecha o diretório.
     }
 
+    // Dispara todas as criações em um único lote.
+    Kernel__dispatch_events_batch(create_events, count);
+    free(create_events);
+
     // Exibe uma mensagem de feedback para o usuário.
     werase(input_win);
     box(input_win, 0, 0);
@@ -368,11 +581,61 @@ void handle_load_all_processes()
     sleep(2); // Pausa para que a mensagem possa ser lida.
 }
 
+/**
+ * @brief Lida com o comando para gravar o relatório de latências (--trace) em arquivo.
+ */
+void handle_trace_dump()
+{
+    const char *report_path = "icarus_trace.txt";
+    FILE *report_file = fopen(report_path, "w");
+    if (report_file)
+    {
+        Trace__dump(report_file);
+        fclose(report_file);
+    }
+
+    // Exibe uma mensagem de feedback para o usuário.
+    werase(input_win);
+    box(input_win, 0, 0);
+    wattron(input_win, COLOR_PAIR(6) | A_BOLD);
+    mvwprintw(input_win, 1, 2, "Comando: ");
+    wattroff(input_win, COLOR_PAIR(6) | A_BOLD);
+    if (report_file)
+    {
+        mvwprintw(input_win, 1, 11, "Relatorio de latencias gravado em '%s'.", report_path);
+    }
+    else
+    {
+        mvwprintw(input_win, 1, 11, "Nao foi possivel gravar '%s'.", report_path);
+    }
+    wrefresh(input_win);
+    sleep(1); // Pausa para que a mensagem possa ser lida.
+}
+
 /**
  * @brief Ponto de entrada principal do programa da interface
+ *
+ * Com "--headless", a simulação roda sem ncurses (ver Interface/headless.h).
  */
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+    {
+        return Headless__run(argc - 2, argv + 2);
+    }
+
+    // Opções do núcleo (ex: --workers) são lidas antes de iniciar o ncurses.
+    for (int i = 1; i < argc; i++)
+    {
+        if (Config__parse_option(argc, argv, &i) <= 0)
+        {
+            fprintf(stderr, "Opcao invalida: '%s'\n", argv[i]);
+            fprintf(stderr, "Uso: icarus_sim [opcoes] | icarus_sim --headless [opcoes] <arquivos>\nOpcoes:\n");
+            Config__print_usage(stderr);
+            return 1;
+        }
+    }
+
     // Inicialização do ncurses e do ambiente do terminal.
     initscr();  // Inicia o modo ncurses
     noecho();   // Não mostra a entrada do usuário na tela
@@ -397,6 +660,12 @@ int main()
 
     // Finaliza o modo ncurses antes de sair do programa.
     endwin();
+
+    // Com --trace, o relatório de latências é impresso ao sair.
+    if (Trace__is_enabled())
+    {
+        Trace__dump(stdout);
+    }
     return 0;
 }
 
@@ -433,7 +702,31 @@ void UI_run_loop()
         {
             handle_load_all_processes(); // Chama o handler para carregar todos os processos.
         }
+        if (ch == '3')
+        {
+            handle_spawn_input(); // Chama o handler para clonar um processo.
+        }
+        if (ch == '+' || ch == '=')
+        {
+            Timescale__faster(); // Acelera a simulação
+        }
+        if (ch == '-')
+        {
+            Timescale__slower(); // Desacelera a simulação
+        }
+        if (ch == 'f' || ch == 'F')
+        {
+            Timescale__toggle_fast_forward(); // Alterna o avanço rápido
+        }
+        if (ch == 'm' || ch == 'M')
+        {
+            show_process_metrics = !show_process_metrics; // Alterna a tabela de processos e a de métricas
+        }
+        if ((ch == 't' || ch == 'T') && Trace__is_enabled())
+        {
+            handle_trace_dump(); // Grava o relatório de latências em arquivo
+        }
 
-        usleep(100000); // Pausa de 100ms para uma taxa de atualização de 10Hz.
+        Timescale__wait_ui_frame(); // Pausa entre redesenhos (10 Hz).
     }
 }
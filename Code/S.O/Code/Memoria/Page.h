@@ -81,11 +81,12 @@ int second_chance_victim_selection();
 void update_page_table_on_load(int owner_process_id, int virtual_page_idx, int physical_frame_idx);
 
 /**
- * @brief Inicializa a tabela de páginas de um processo a partir do arquivo de definição.
+ * @brief Inicializa a tabela de páginas de um processo.
  * @param owner_process_id PID do processo.
- * @param process_definition_file Caminho para o arquivo de definição do processo.
+ * @param pages_required Páginas virtuais calculadas na leitura do programa (limitadas a
+ * MAX_RESIDENT_PAGES_PER_PROCESS).
  */
-void initialize_process_specific_page_table(int owner_process_id, const char *process_definition_file);
+void initialize_process_specific_page_table(int owner_process_id, int pages_required);
 
 /**
  * @brief Exibe o estado da memória física (para debug ou visualização).
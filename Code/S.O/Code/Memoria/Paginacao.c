@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include "Page.h"
 
 #define USABLE_PHYSICAL_FRAMES (TOTAL_PHYSICAL_PAGES - OS_RESERVED_PAGES_COUNT) // Quadros físicos utilizáveis (exclui reservados para o SO)
@@ -17,6 +18,10 @@ ProcessPageTable process_page_table_registry[MAX_SIMULTANEOUS_PROCESSES];
 // Ponteiro do relógio para o algoritmo Segunda Chance
 int second_chance_clock_hand = 0;
 
+// Protege os quadros e o registro de tabelas: processos são criados e finalizados
+// por workers diferentes ao mesmo tempo.
+static pthread_mutex_t memory_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 // -------------------- Inicialização das estruturas de memória --------------------
 
 void initialize_memory_management()
@@ -80,7 +85,7 @@ void update_page_table_on_load(int process_id_val, int virtual_page_index, int p
 
 // ------------------ Carregamento de página virtual para quadro físico --------------------
 
-int load_virtual_page_to_frame(int process_id_val, int virtual_page_index)
+static int load_virtual_page_to_frame_locked(int process_id_val, int virtual_page_index)
 {
     // Busca a tabela de páginas do processo
     int i;
@@ -148,10 +153,19 @@ int load_virtual_page_to_frame(int process_id_val, int virtual_page_index)
     return target_frame_idx;
 }
 
+int load_virtual_page_to_frame(int process_id_val, int virtual_page_index)
+{
+    pthread_mutex_lock(&memory_mutex);
+    int frame_idx = load_virtual_page_to_frame_locked(process_id_val, virtual_page_index);
+    pthread_mutex_unlock(&memory_mutex);
+    return frame_idx;
+}
+
 // -------------------- Liberação de quadros físicos de um processo --------------------
 
 void release_process_frames(int process_id_val)
 {
+    pthread_mutex_lock(&memory_mutex);
     // Libera todos os quadros físicos ocupados pelo processo
     for (int i = 0; i < USABLE_PHYSICAL_FRAMES; i++)
     {
@@ -179,49 +193,21 @@ void release_process_frames(int process_id_val)
             break;
         }
     }
+    pthread_mutex_unlock(&memory_mutex);
 }
 
 // -------------------- Inicialização da tabela de páginas de um processo --------------------
 
-void initialize_process_specific_page_table(int process_id_val, const char *process_file_path)
+void initialize_process_specific_page_table(int process_id_val, int pages_required)
 {
-    // Lê o arquivo de definição do processo para calcular o número de páginas necessárias
-    FILE *fp = fopen(process_file_path, "r");
-    if (!fp)
-    {
-        return;
-    }
-
-    char line_buffer[128];
-    int total_exec_instruction_time = 0;
-    int header_lines_to_skip = 5;
-
-    // Ignora as linhas de cabeçalho do arquivo
-    for (int i = 0; i < header_lines_to_skip && fgets(line_buffer, sizeof(line_buffer), fp); i++)
-        ;
-
-    // Soma o tempo total das instruções 'exec'
-    while (fgets(line_buffer, sizeof(line_buffer), fp))
-    {
-        char instruction_word[16];
-        int value_param;
-        if (sscanf(line_buffer, "%s %d", instruction_word, &value_param) == 2)
-        {
-            if (strcmp(instruction_word, "exec") == 0)
-            {
-                total_exec_instruction_time += value_param;
-            }
-        }
-    }
-    fclose(fp);
-
-    // Calcula o número de páginas necessárias para o processo
-    int num_of_pages = (total_exec_instruction_time + PAGE_SIZE_IN_BYTES - 1) / PAGE_SIZE_IN_BYTES;
-    if (num_of_pages == 0 && total_exec_instruction_time > 0)
-        num_of_pages = 1;
+    // O número de páginas vem dos metadados do programa, calculados na leitura do arquivo
+    int num_of_pages = pages_required;
+    if (num_of_pages < 0)
+        num_of_pages = 0;
     if (num_of_pages > MAX_RESIDENT_PAGES_PER_PROCESS)
         num_of_pages = MAX_RESIDENT_PAGES_PER_PROCESS;
 
+    pthread_mutex_lock(&memory_mutex);
     // Procura um slot livre no registro de tabelas de páginas
     for (int i = 0; i < MAX_SIMULTANEOUS_PROCESSES; i++)
     {
@@ -234,7 +220,7 @@ void initialize_process_specific_page_table(int process_id_val, const char *proc
             if (process_page_table_registry[i].entries_table == NULL && num_of_pages > 0)
             {
                 process_page_table_registry[i].owner_process_id = -1;
-                return;
+                break;
             }
             // Inicializa todas as entradas da tabela de páginas como não presentes
             for (int j = 0; j < num_of_pages; j++)
@@ -246,6 +232,7 @@ void initialize_process_specific_page_table(int process_id_val, const char *proc
             break;
         }
     }
+    pthread_mutex_unlock(&memory_mutex);
 }
 
 // -------------------- Função getter para a UI visualizar o estado da memória --------------------
@@ -254,10 +241,12 @@ void initialize_process_specific_page_table(int process_id_val, const char *proc
 int get_memory_frames_state(PhysicalFrame *buffer, int buffer_size)
 {
     int count = 0;
+    pthread_mutex_lock(&memory_mutex);
     for (int i = 0; i < USABLE_PHYSICAL_FRAMES && i < buffer_size; i++)
     {
         buffer[i] = physical_memory_frames[i];
         count++;
     }
+    pthread_mutex_unlock(&memory_mutex);
     return count;
 }
\ No newline at end of file
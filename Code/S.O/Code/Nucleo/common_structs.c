@@ -0,0 +1,26 @@
+#include "common_structs.h"
+#include "../Ferramentas/object_pool.h"
+
+// Pools dos argumentos de eventos
+static ObjectPool io_args_pool = OBJECT_POOL_INITIALIZER("IOArgs", sizeof(IOArgs));
+static ObjectPool sema_args_pool = OBJECT_POOL_INITIALIZER("SemaArgs", sizeof(SemaArgs));
+
+IOArgs *allocate_io_args()
+{
+    return (IOArgs *)object_pool_alloc(&io_args_pool);
+}
+
+void release_io_args(IOArgs *args)
+{
+    object_pool_free(&io_args_pool, args);
+}
+
+SemaArgs *allocate_sema_args()
+{
+    return (SemaArgs *)object_pool_alloc(&sema_args_pool);
+}
+
+void release_sema_args(SemaArgs *args)
+{
+    object_pool_free(&sema_args_pool, args);
+}
@@ -42,4 +42,33 @@ typedef struct
     int value;    // Parâmetro específico: trilha de disco, tempo de impressão, etc.
 } IOArgs;
 
+/**
+ * @brief Argumentos para a criação de várias cópias de um processo.
+ *
+ * Utilizado no evento EVT_PROCESS_SPAWN; o handler libera a estrutura e o caminho.
+ */
+typedef struct
+{
+    char *file_path; // Caminho do arquivo de definição do processo (alocado com malloc)
+    int count;       // Quantidade de processos a criar (o modelo e suas cópias)
+} SpawnArgs;
+
+// -----------------------------------------------------------------------------
+// Alocação dos argumentos de eventos. Os argumentos são criados a cada instrução
+// de I/O ou semáforo e liberados pelo handler do kernel, por isso vêm de pools
+// de objetos em vez do malloc.
+// -----------------------------------------------------------------------------
+
+/** @brief Aloca argumentos de I/O (conteúdo não inicializado). */
+IOArgs *allocate_io_args();
+
+/** @brief Devolve ao pool argumentos obtidos com allocate_io_args. */
+void release_io_args(IOArgs *args);
+
+/** @brief Aloca argumentos de semáforo (conteúdo não inicializado). */
+SemaArgs *allocate_sema_args();
+
+/** @brief Devolve ao pool argumentos obtidos com allocate_sema_args. */
+void release_sema_args(SemaArgs *args);
+
 #endif // COMMON_STRUCTS_H_GUARD
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // Para sysconf
+#include "../Clock/timescale.h"
+#include "../escalonador/sched_class.h"
+
+// -----------------------------------------------------------------------------
+// Configuração padrão do núcleo
+// -----------------------------------------------------------------------------
+KernelConfig kernel_config = {
+    .handler_worker_count = 0,
+    .deterministic = 0,
+    .trace_enabled = 0,
+    .echo_errors_to_stderr = 0,
+    .fuse_exec = 1,
+    .sched_policy = "io",
+    .quantum = 0,
+    .cpu_core_count = 1,
+};
+
+// Lê o valor inteiro positivo de uma opção. Retorna -1 se ausente ou inválido.
+static int read_positive_value(int argc, char *argv[], int *index)
+{
+    if (*index + 1 >= argc)
+        return -1;
+    char *end_ptr;
+    long value = strtol(argv[*index + 1], &end_ptr, 10);
+    if (*end_ptr != '\0' || value <= 0)
+        return -1;
+    (*index)++;
+    return (int)value;
+}
+
+int Config__parse_option(int argc, char *argv[], int *index)
+{
+    const char *option = argv[*index];
+    if (strcmp(option, "--workers") == 0)
+    {
+        int value = read_positive_value(argc, argv, index);
+        if (value < 0)
+            return -1;
+        kernel_config.handler_worker_count = value;
+        return 1;
+    }
+    if (strcmp(option, "--timescale") == 0)
+    {
+        if (*index + 1 >= argc || Timescale__configure(argv[*index + 1]) != 0)
+            return -1;
+        (*index)++;
+        return 1;
+    }
+    if (strcmp(option, "--trace") == 0)
+    {
+        kernel_config.trace_enabled = 1;
+        return 1;
+    }
+    if (strcmp(option, "--deterministic") == 0)
+    {
+        kernel_config.deterministic = 1;
+        return 1;
+    }
+    if (strcmp(option, "--no-fusion") == 0)
+    {
+        kernel_config.fuse_exec = 0;
+        return 1;
+    }
+    if (strcmp(option, "--quantum") == 0)
+    {
+        int value = read_positive_value(argc, argv, index);
+        if (value < 0)
+            return -1;
+        kernel_config.quantum = value;
+        return 1;
+    }
+    if (strcmp(option, "--cores") == 0)
+    {
+        int value = read_positive_value(argc, argv, index);
+        if (value < 0 || value > CONFIG_MAX_CPU_CORES)
+            return -1;
+        kernel_config.cpu_core_count = value;
+        return 1;
+    }
+    if (strcmp(option, "--sched") == 0)
+    {
+        if (*index + 1 >= argc || SchedClass__find(argv[*index + 1]) == NULL)
+            return -1;
+        kernel_config.sched_policy = argv[++(*index)];
+        return 1;
+    }
+    return 0;
+}
+
+void Config__print_usage(FILE *output)
+{
+    fprintf(output, "  --workers <n>   Threads de tratamento de eventos (padrao: numero de nucleos)\n");
+    fprintf(output, "  --timescale <m> Escala de tempo: afap, realtime, step:<us> ou ratio:<ns por unidade>\n");
+    fprintf(output, "  --deterministic Avanca o tempo virtual so apos o instante atual se estabilizar\n");
+    fprintf(output, "  --trace         Mede a latencia de cada tipo de evento do kernel\n");
+    fprintf(output, "  --no-fusion     Executa cada 'exec' separadamente, sem fundir rajadas de CPU\n");
+    fprintf(output, "  --sched <p>     Politica de escalonamento: ");
+    SchedClass__print_names(output);
+    fprintf(output, " (padrao: %s)\n", kernel_config.sched_policy);
+    fprintf(output, "  --quantum <n>   Preempta o processo apos n unidades de CPU (padrao: sem quantum)\n");
+    fprintf(output, "  --cores <n>     Nucleos de CPU simulados, de 1 a %d (padrao: 1)\n", CONFIG_MAX_CPU_CORES);
+}
+
+int Config__get_handler_worker_count()
+{
+    if (kernel_config.handler_worker_count > 0)
+        return kernel_config.handler_worker_count;
+    long online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return online_cpus > 0 ? (int)online_cpus : 1;
+}
@@ -0,0 +1,49 @@
+#ifndef CONFIG_H_GUARD
+#define CONFIG_H_GUARD
+
+#include <stdio.h>
+
+#define CONFIG_MAX_CPU_CORES 64 // Limite de núcleos simulados (--cores)
+
+/**
+ * @brief Parâmetros de configuração do núcleo, definidos antes de Kernel__initialize().
+ *
+ * Os valores padrão são definidos em config.c e podem ser alterados pela
+ * linha de comando (ver Config__parse_option).
+ */
+typedef struct KernelConfig_s
+{
+    int handler_worker_count; // Threads que tratam eventos do kernel (0 = número de núcleos disponíveis)
+    int deterministic;        // 1 = o clock só avança após todo o trabalho do instante atual terminar
+    int trace_enabled;        // 1 = registra a latência de cada evento do kernel (ver trace.h)
+    int echo_errors_to_stderr; // 1 = erros do log do kernel também vão para stderr (sem interface)
+    int fuse_exec;            // 1 = instruções 'exec' consecutivas viram uma única rajada de CPU
+    const char *sched_policy; // Nome da classe de escalonamento (ver sched_class.h)
+    int quantum;              // Fatia de CPU, em unidades de tempo virtual (0 = sem preempção por tempo)
+    int cpu_core_count;       // Núcleos de CPU simulados, cada um com sua fila de prontos
+} KernelConfig;
+
+// Configuração global, lida pelos módulos durante a inicialização.
+extern KernelConfig kernel_config;
+
+/**
+ * @brief Interpreta uma opção de linha de comando do núcleo.
+ *
+ * @param argc  Quantidade de argumentos.
+ * @param argv  Vetor de argumentos.
+ * @param index Índice do argumento atual; avança se a opção consumir um valor.
+ * @return 1 se a opção foi reconhecida, 0 se não é uma opção do núcleo, -1 se o valor é inválido.
+ */
+int Config__parse_option(int argc, char *argv[], int *index);
+
+/**
+ * @brief Imprime a descrição das opções aceitas por Config__parse_option.
+ */
+void Config__print_usage(FILE *output);
+
+/**
+ * @brief Retorna o número efetivo de threads de tratamento de eventos.
+ */
+int Config__get_handler_worker_count();
+
+#endif // CONFIG_H_GUARD
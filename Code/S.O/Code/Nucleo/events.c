@@ -1,6 +1,11 @@
 #include "events.h"
+#include "../Ferramentas/object_pool.h"
 #include <stdlib.h> // Necessário para definição de NULL
 
+// Pool dos containers de evento: cada instrução gera ao menos um evento, e o
+// clock e o kernel alocam/liberam um por despacho.
+static ObjectPool kernel_event_pool = OBJECT_POOL_INITIALIZER("KernelEvent", sizeof(KernelEvent));
+
 // -----------------------------------------------------------------------------
 // Função de comparação de ponteiros de eventos.
 // Retorna 0 se os ponteiros forem iguais (mesmo evento), 1 caso contrário.
@@ -16,6 +21,7 @@ int compare_event(void *a, void *b)
 // -----------------------------------------------------------------------------
 // Função de comparação de eventos pelo tempo de execução.
 // Retorna -1 se a < b, 1 se a > b, 0 se iguais.
+// Eventos do mesmo instante são ordenados por tipo, PID e sequência de agendamento (FIFO).
 // Usada para ordenação de eventos futuros na fila do clock.
 // -----------------------------------------------------------------------------
 int compare_event_time(void *a, void *b)
@@ -30,5 +36,72 @@ int compare_event_time(void *a, void *b)
     {
         return 1;
     }
+    if (event_a->type != event_b->type)
+    {
+        return (event_a->type < event_b->type) ? -1 : 1;
+    }
+    if (event_a->process_id != event_b->process_id)
+    {
+        return (event_a->process_id < event_b->process_id) ? -1 : 1;
+    }
+    if (event_a->sequence < event_b->sequence)
+    {
+        return -1;
+    }
+    if (event_a->sequence > event_b->sequence)
+    {
+        return 1;
+    }
     return 0;
-}
\ No newline at end of file
+}
+
+// -----------------------------------------------------------------------------
+// Nome de um tipo de evento, usado nos relatórios de rastreamento.
+// -----------------------------------------------------------------------------
+const char *event_type_name(EventType type)
+{
+    switch (type)
+    {
+    case EVT_PROCESS_INTERRUPT:
+        return "EVT_PROCESS_INTERRUPT";
+    case EVT_PROCESS_CREATE:
+        return "EVT_PROCESS_CREATE";
+    case EVT_PROCESS_FINISH:
+        return "EVT_PROCESS_FINISH";
+    case EVT_DISK_REQUEST:
+        return "EVT_DISK_REQUEST";
+    case EVT_DISK_FINISH:
+        return "EVT_DISK_FINISH";
+    case EVT_MEM_LOAD_REQ:
+        return "EVT_MEM_LOAD_REQ";
+    case EVT_MEM_LOAD_FINISH:
+        return "EVT_MEM_LOAD_FINISH";
+    case EVT_SEMAPHORE_P:
+        return "EVT_SEMAPHORE_P";
+    case EVT_SEMAPHORE_V:
+        return "EVT_SEMAPHORE_V";
+    case EVT_PRINT_REQUEST:
+        return "EVT_PRINT_REQUEST";
+    case EVT_PRINT_FINISH:
+        return "EVT_PRINT_FINISH";
+    case EVT_PROCESS_SPAWN:
+        return "EVT_PROCESS_SPAWN";
+    case EVT_CPU_TIMER_FINISH:
+        return "EVT_CPU_TIMER_FINISH";
+    default:
+        return "EVT_DESCONHECIDO";
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Alocação de eventos a partir do pool.
+// -----------------------------------------------------------------------------
+KernelEvent *allocate_kernel_event()
+{
+    return (KernelEvent *)object_pool_alloc(&kernel_event_pool);
+}
+
+void release_kernel_event(KernelEvent *event)
+{
+    object_pool_free(&kernel_event_pool, event);
+}
@@ -2,6 +2,7 @@
 #define EVENTS_H_GUARD
 
 #include <stdlib.h>
+#include "../Ferramentas/mpsc_queue.h"
 
 /**
  * @brief Enumeração dos tipos de eventos do núcleo.
@@ -22,7 +23,9 @@ typedef enum
     EVT_SEMAPHORE_V = 11,      // Operação V (signal) em semáforo
     EVT_PRINT_REQUEST = 14,    // Requisição de impressão
     EVT_PRINT_FINISH = 15,     // Conclusão de impressão
-    EVT_CPU_TIMER_FINISH       // Evento de término de fatia de tempo da CPU
+    EVT_PROCESS_SPAWN = 16,    // Criação de várias cópias de um processo (SpawnArgs)
+    EVT_CPU_TIMER_FINISH,      // Evento de término de fatia de tempo da CPU
+    EVT_TYPE_COUNT             // Limite dos valores acima (não é um evento)
 } EventType;
 
 /**
@@ -31,12 +34,21 @@ typedef enum
  * type: Tipo do evento (EventType)
  * data: Ponteiro genérico para dados adicionais do evento
  * execution_time: Momento (clock virtual) em que o evento deve ser processado
+ * sequence: Ordem de agendamento no clock (desempate entre eventos do mesmo instante)
+ * process_id: PID do processo envolvido (0 se nenhum), usado no desempate e na afinidade de workers
+ * enqueue_ns/dequeue_ns: Instantes reais de entrada e saída da fila do kernel (só com --trace)
+ * queue_node: Ligação intrusiva usada pela fila de eventos do kernel (deve ser o primeiro campo)
  */
-typedef struct
+typedef struct KernelEvent_s
 {
+    MpscNode queue_node;
     EventType type;
     void *data;
     long long execution_time;
+    unsigned long long sequence;
+    int process_id;
+    long long enqueue_ns;
+    long long dequeue_ns;
 } KernelEvent;
 
 /**
@@ -46,9 +58,28 @@ typedef struct
 int compare_event(void *a, void *b);
 
 /**
- * @brief Compara dois eventos pelo tempo de execução.
+ * @brief Compara dois eventos pelo tempo de execução e, em caso de empate,
+ * pelo tipo, pelo PID e, por fim, pela ordem de agendamento (o mais antigo primeiro).
+ * Os desempates por tipo e PID não dependem da ordem em que threads concorrentes
+ * agendaram os eventos, o que torna o modo determinístico reproduzível.
  * Retorna -1 se a < b, 1 se a > b, 0 se iguais.
  */
 int compare_event_time(void *a, void *b);
 
+/**
+ * @brief Retorna o nome de um tipo de evento (ex: "EVT_DISK_REQUEST").
+ */
+const char *event_type_name(EventType type);
+
+/**
+ * @brief Aloca um evento do pool de eventos do kernel (conteúdo não inicializado).
+ * Retorna NULL em caso de falta de memória.
+ */
+KernelEvent *allocate_kernel_event();
+
+/**
+ * @brief Devolve ao pool um evento obtido com allocate_kernel_event.
+ */
+void release_kernel_event(KernelEvent *event);
+
 #endif // EVENTS_H_GUARD
\ No newline at end of file
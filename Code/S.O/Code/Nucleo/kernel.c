@@ -4,21 +4,29 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <time.h>
+#include <stdarg.h>
 #include "../Clock/clock.h"
 #include "../CPU/cpu.h"
 #include "../Memoria/Page.h"
 #include "common_structs.h"
 #include "../escalonador/scheduler.h"
 #include "../Ferramentas/compare.h"
+#include "config.h"
+#include "worker_pool.h"
+#include "trace.h"
+#include "thread_stats.h"
 
 // -----------------------------------------------------------------------------
 // Definição das variáveis globais do núcleo do sistema operacional
 // -----------------------------------------------------------------------------
 Kernel *kernel_instance;           // Instância principal do kernel
-List *event_queue;                 // Fila de eventos pendentes
-pthread_mutex_t event_queue_mutex; // Mutex para proteger a fila de eventos
-pthread_cond_t event_queue_cond;   // Condição para sinalizar novos eventos
-pthread_mutex_t pcb_list_mutex;    // Mutex para proteger a lista de PCBs
+MpscQueue event_queue;             // Fila de eventos pendentes (sem travas)
+pthread_mutex_t process_table_mutex; // Mutex para proteger a tabela de processos
+
+#define MAX_LOG_MESSAGES 15 // Define o tamanho máximo do log da UI
+
+static void handle_kernel_event(KernelEvent *current_event);
 
 // -----------------------------------------------------------------------------
 // Inicialização do kernel e de todos os módulos do sistema operacional
@@ -31,169 +39,395 @@ void Kernel__initialize()
         exit(1);
     }
     kernel_instance->proc_id_counter = 1;
-    kernel_instance->pcb_list = create_list();
+    ProcessTable__init(&kernel_instance->process_table);
     kernel_instance->semaphore_table = create_list();
     kernel_instance->scheduler = Scheduler__create();
-    kernel_instance->running_process = NULL;
+    for (int core = 0; core < CONFIG_MAX_CPU_CORES; core++)
+        kernel_instance->running_process[core] = NULL;
     kernel_instance->scheduler_log = create_list();
+    kernel_instance->terminated_process_count = 0;
+    kernel_instance->failed_process_count = 0;
+    kernel_instance->dispatched_event_count = 0;
+    pthread_cond_init(&kernel_instance->termination_cond, NULL);
     pthread_mutex_init(&kernel_instance->scheduler_log_mutex, NULL);
     pthread_mutex_init(&kernel_instance->semaphore_table_mutex, NULL);
-    event_queue = create_list();
-    pthread_mutex_init(&pcb_list_mutex, NULL);
-    pthread_mutex_init(&event_queue_mutex, NULL);
-    pthread_cond_init(&event_queue_cond, NULL);
+    mpsc_queue_init(&event_queue);
+    pthread_mutex_init(&process_table_mutex, NULL);
+    WorkerPool__initialize(Config__get_handler_worker_count(), handle_kernel_event);
     initialize_memory_management();
     IOManager__initialize();
     CPU__initialize();
     Clock__initialize();
 }
 
+// -----------------------------------------------------------------------------
+// Log do kernel exibido na interface
+// -----------------------------------------------------------------------------
+void Kernel__log_message(const char *format, ...)
+{
+    char log_buffer[512];
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(log_buffer, sizeof(log_buffer), format, arguments);
+    va_end(arguments);
+
+    // Adiciona a mensagem ao log de forma segura (o log tem seu próprio mutex)
+    pthread_mutex_lock(&kernel_instance->scheduler_log_mutex);
+    // Mantém o log com um tamanho gerenciável
+    while (kernel_instance->scheduler_log->size >= MAX_LOG_MESSAGES)
+    {
+        Node *old_node = kernel_instance->scheduler_log->head;
+        void *data_to_free = old_node->data;
+        remove_from_list(kernel_instance->scheduler_log, data_to_free, compare_strings_func);
+        free(data_to_free); // Libera a string antiga
+    }
+    add_to_list(kernel_instance->scheduler_log, strdup(log_buffer));
+    pthread_mutex_unlock(&kernel_instance->scheduler_log_mutex);
+
+    // Sem interface (modo headless), os erros também vão para a saída de erro.
+    if (kernel_config.echo_errors_to_stderr && strncmp(log_buffer, "ERRO", 4) == 0)
+    {
+        fprintf(stderr, "%s\n", log_buffer);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Função para despachar (agendar) um novo evento para o kernel
 // -----------------------------------------------------------------------------
 void Kernel__dispatch_event(EventType type, void *data)
 {
-    KernelEvent *event = malloc(sizeof(KernelEvent));
+    KernelEvent *event = allocate_kernel_event();
     event->type = type;
     event->data = data;
-    pthread_mutex_lock(&event_queue_mutex);
-    add_to_list(event_queue, event);
-    pthread_cond_signal(&event_queue_cond);
-    pthread_mutex_unlock(&event_queue_mutex);
+    event->process_id = Kernel__get_event_process_id(type, data);
+    event->enqueue_ns = Trace__is_enabled() ? Trace__now_ns() : 0;
+    Clock__begin_activity(); // O evento conta como trabalho do instante atual até seu handler terminar
+    __atomic_fetch_add(&kernel_instance->dispatched_event_count, 1, __ATOMIC_RELAXED);
+    // Publica sem travas; o consumidor só é acordado se estiver dormindo.
+    mpsc_queue_push(&event_queue, &event->queue_node);
 }
 
 // -----------------------------------------------------------------------------
-// Loop principal de simulação do kernel: processa eventos da fila
-// Cada evento é tratado por uma thread específica, conforme seu tipo
+// Função para despachar vários eventos com uma única publicação na fila
 // -----------------------------------------------------------------------------
-void Kernel__run_simulation()
+void Kernel__dispatch_events_batch(const EventDispatch *events, int count)
 {
-    while (1)
+    if (count <= 0)
+        return;
+
+    long long enqueue_ns = Trace__is_enabled() ? Trace__now_ns() : 0;
+    KernelEvent *first_event = NULL;
+    KernelEvent *last_event = NULL;
+    for (int i = 0; i < count; i++)
+    {
+        KernelEvent *event = allocate_kernel_event();
+        event->type = events[i].type;
+        event->data = events[i].data;
+        event->process_id = Kernel__get_event_process_id(events[i].type, events[i].data);
+        event->enqueue_ns = enqueue_ns;
+        Clock__begin_activity();
+
+        // Encadeia localmente; só a publicação abaixo é visível ao consumidor.
+        if (last_event == NULL)
+            first_event = event;
+        else
+            atomic_store_explicit(&last_event->queue_node.next, &event->queue_node, memory_order_relaxed);
+        last_event = event;
+    }
+    __atomic_fetch_add(&kernel_instance->dispatched_event_count, count, __ATOMIC_RELAXED);
+    mpsc_queue_push_chain(&event_queue, &first_event->queue_node, &last_event->queue_node);
+}
+
+// -----------------------------------------------------------------------------
+// Espera até que a quantidade esperada de processos tenha terminado
+// -----------------------------------------------------------------------------
+// Verifica se nada mais pode fazer a simulação avançar: nenhum evento agendado no clock,
+// nenhum processo em execução ou pronto e nenhum trabalho do instante atual em andamento.
+// Uma escala de tempo lenta apenas espaça os eventos, sem esvaziar o clock.
+static int simulation_is_stalled()
+{
+    if (Clock__get_pending_event_count() > 0 || Clock__get_pending_activity() > 0)
+        return 0;
+    if (__atomic_load_n(&kernel_instance->scheduler->ready_count, __ATOMIC_RELAXED) > 0)
+        return 0;
+    for (int core = 0; core < CPU__get_core_count(); core++)
+    {
+        if (__atomic_load_n(&kernel_instance->running_process[core], __ATOMIC_RELAXED) != NULL)
+            return 0;
+    }
+    return 1;
+}
+
+int Kernel__wait_for_terminations(int expected_count, int stall_timeout_ms)
+{
+    long long last_event_count = -1;
+    pthread_mutex_lock(&process_table_mutex);
+    while (kernel_instance->terminated_process_count + kernel_instance->failed_process_count < expected_count)
     {
-        pthread_mutex_lock(&event_queue_mutex);
-        while (event_queue->size == 0)
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += stall_timeout_ms / 1000;
+        deadline.tv_nsec += (long)(stall_timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
         {
-            pthread_cond_wait(&event_queue_cond, &event_queue_mutex);
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
         }
 
-        Node *event_node = event_queue->head;
-        KernelEvent *current_event = (KernelEvent *)event_node->data;
-        remove_from_list(event_queue, current_event, compare_event);
-        pthread_mutex_unlock(&event_queue_mutex);
+        if (pthread_cond_timedwait(&kernel_instance->termination_cond, &process_table_mutex, &deadline) != 0)
+        {
+            // Sem término no intervalo: verifica se a simulação ainda progride.
+            long long event_count = __atomic_load_n(&kernel_instance->dispatched_event_count, __ATOMIC_RELAXED);
+            if (event_count == last_event_count && simulation_is_stalled())
+            {
+                break; // Nenhum evento novo e nada pendente: simulação parada.
+            }
+            last_event_count = event_count;
+        }
+    }
+    int ended_count = kernel_instance->terminated_process_count + kernel_instance->failed_process_count;
+    pthread_mutex_unlock(&process_table_mutex);
+    return ended_count;
+}
+
+// Contabiliza um processo encerrado e acorda quem espera pelo fim da carga
+static void count_process_termination()
+{
+    pthread_mutex_lock(&process_table_mutex);
+    kernel_instance->terminated_process_count++;
+    pthread_cond_broadcast(&kernel_instance->termination_cond);
+    pthread_mutex_unlock(&process_table_mutex);
+}
 
-        void *(*thread_handler)(void *) = NULL;
+// Contabiliza processos que não puderam ser criados, para que quem aguarda a carga
+// de trabalho não espere por eles (e possa relatar a falha).
+static void count_process_load_failures(int count)
+{
+    pthread_mutex_lock(&process_table_mutex);
+    kernel_instance->failed_process_count += count;
+    pthread_cond_broadcast(&kernel_instance->termination_cond);
+    pthread_mutex_unlock(&process_table_mutex);
+}
 
-        // Seleciona o handler apropriado para o tipo de evento
-        switch (current_event->type)
+// O núcleo do processo só muda enquanto ele está na fila de prontos (roubo de trabalho),
+// sob a trava da CPU.
+int Kernel__is_running(const Bcp *process)
+{
+    return kernel_instance->running_process[process->cpu_core] == process;
+}
+
+// -----------------------------------------------------------------------------
+// PID do processo envolvido em um evento, de acordo com o tipo dos seus dados.
+// -----------------------------------------------------------------------------
+int Kernel__get_event_process_id(EventType type, void *data)
+{
+    switch (type)
+    {
+    case EVT_PROCESS_INTERRUPT:
+    case EVT_PROCESS_FINISH:
+    case EVT_CPU_TIMER_FINISH:
+    case EVT_DISK_FINISH:
+    case EVT_PRINT_FINISH:
+    case EVT_MEM_LOAD_REQ:
+    case EVT_MEM_LOAD_FINISH:
+        return ((Bcp *)data)->pid;
+    case EVT_DISK_REQUEST:
+    case EVT_PRINT_REQUEST:
+        return ((IOArgs *)data)->process->pid;
+    case EVT_SEMAPHORE_P:
+    case EVT_SEMAPHORE_V:
+        return ((SemaArgs *)data)->process->pid;
+    default:
+        return 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Trata um evento, chamando o handler apropriado para o seu tipo.
+// Executada pelas threads do pool de workers.
+// -----------------------------------------------------------------------------
+static void handle_kernel_event(KernelEvent *current_event)
+{
+    void *(*thread_handler)(void *) = NULL;
+
+    // Seleciona o handler apropriado para o tipo de evento
+    switch (current_event->type)
+    {
+    case EVT_PROCESS_CREATE:
+        thread_handler = thread_handler_process_create;
+        break;
+    case EVT_PROCESS_SPAWN:
+        thread_handler = thread_handler_process_spawn;
+        break;
+    case EVT_PROCESS_FINISH:
+        thread_handler = thread_handler_process_finish;
+        break;
+    case EVT_CPU_TIMER_FINISH:
+        thread_handler = thread_handler_cpu_timer_finish;
+        break;
+    case EVT_PROCESS_INTERRUPT:
+        thread_handler = thread_handler_process_interrupt;
+        break;
+    case EVT_DISK_REQUEST:
+        thread_handler = thread_handler_disk_request;
+        break;
+    case EVT_DISK_FINISH:
+        thread_handler = thread_handler_disk_finish;
+        break;
+    case EVT_PRINT_REQUEST:
+        thread_handler = thread_handler_print_request;
+        break;
+    case EVT_PRINT_FINISH:
+        thread_handler = thread_handler_print_finish;
+        break;
+    case EVT_SEMAPHORE_P:
+        thread_handler = thread_handler_semaphore_p;
+        break;
+    case EVT_SEMAPHORE_V:
+        thread_handler = thread_handler_semaphore_v;
+        break;
+    case EVT_MEM_LOAD_REQ:
+        thread_handler = thread_handler_mem_load_req;
+        break;
+    case EVT_MEM_LOAD_FINISH:
+        thread_handler = thread_handler_mem_load_finish;
+        break;
+    default:
+        break;
+    }
+
+    if (thread_handler)
+    {
+        if (Trace__is_enabled())
         {
-        case EVT_PROCESS_CREATE:
-            thread_handler = thread_handler_process_create;
-            break;
-        case EVT_PROCESS_FINISH:
-            thread_handler = thread_handler_process_finish;
-            break;
-        case EVT_CPU_TIMER_FINISH:
-            thread_handler = thread_handler_cpu_timer_finish;
-            break;
-        case EVT_DISK_REQUEST:
-            thread_handler = thread_handler_disk_request;
-            break;
-        case EVT_DISK_FINISH:
-            thread_handler = thread_handler_disk_finish;
-            break;
-        case EVT_PRINT_REQUEST:
-            thread_handler = thread_handler_print_request;
-            break;
-        case EVT_PRINT_FINISH:
-            thread_handler = thread_handler_print_finish;
-            break;
-        case EVT_SEMAPHORE_P:
-            thread_handler = thread_handler_semaphore_p;
-            break;
-        case EVT_SEMAPHORE_V:
-            thread_handler = thread_handler_semaphore_v;
-            break;
-        case EVT_MEM_LOAD_REQ:
-            thread_handler = thread_handler_mem_load_req;
-            break;
-        case EVT_MEM_LOAD_FINISH:
-            thread_handler = thread_handler_mem_load_finish;
-            break;
-        default:
-            break;
+            long long handler_start_ns = Trace__now_ns();
+            thread_handler(current_event->data);
+            Trace__record_event(current_event, handler_start_ns, Trace__now_ns());
         }
+        else
+        {
+            thread_handler(current_event->data);
+        }
+    }
+    Clock__end_activity();
+}
 
-        // Cria uma thread para tratar o evento, se houver handler definido
-        if (thread_handler)
+// -----------------------------------------------------------------------------
+// Loop principal de simulação do kernel: processa eventos da fila
+// Cada evento é repassado ao worker do pool responsável pelo seu processo
+// -----------------------------------------------------------------------------
+void Kernel__run_simulation()
+{
+    ThreadStats__register_current(SUBSYSTEM_KERNEL_LOOP);
+    while (1)
+    {
+        // Retira o próximo evento; gira brevemente e dorme em um futex se a fila estiver vazia.
+        KernelEvent *current_event = (KernelEvent *)mpsc_queue_pop_wait(&event_queue);
+        if (Trace__is_enabled())
         {
-            pthread_t tid;
-            pthread_create(&tid, NULL, thread_handler, current_event->data);
-            pthread_detach(tid);
+            current_event->dequeue_ns = Trace__now_ns();
         }
-        free(current_event);
+
+        // O worker assume a posse do evento e o libera após tratá-lo.
+        // A chave de afinidade é o PID: eventos do mesmo processo caem sempre no mesmo
+        // worker e são tratados em ordem; criações de processo (PID 0) são serializadas.
+        WorkerPool__submit(current_event, (unsigned int)current_event->process_id);
     }
 }
 
 /* --- Implementação dos Handlers de Thread para cada tipo de evento --- */
 
+// Marca que o kernel concluiu a operação P/V solicitada pelo processo,
+// liberando-o novamente para preempção.
+static void complete_syscall(Bcp *pcb)
+{
+    CPU__lock();
+    pcb->pending_syscall = 0;
+    CPU__unlock();
+}
+
 // Handler para criação de processo
 void *thread_handler_process_create(void *args)
 {
     char *file_path = (char *)args;
-    Bcp *new_pcb = Process__create(file_path);
-    if (new_pcb)
+    char error_message[512];
+    Bcp *new_pcb = Process__create(file_path, error_message, sizeof(error_message));
+    if (!new_pcb)
     {
-        pthread_mutex_lock(&pcb_list_mutex);
-        add_to_list(kernel_instance->pcb_list, new_pcb);
-        pthread_mutex_unlock(&pcb_list_mutex);
+        Kernel__log_message("ERRO: %s", error_message);
+        count_process_load_failures(1);
     }
     free(file_path);
     return NULL;
 }
 
+// Handler para criação de várias cópias de um processo
+void *thread_handler_process_spawn(void *args)
+{
+    SpawnArgs *spawn_args = (SpawnArgs *)args;
+    char error_message[512];
+    int not_created = spawn_args->count;
+
+    // O modelo só é iniciado depois das cópias, para que não termine durante a cópia.
+    Bcp *template_pcb = Process__create_unstarted(spawn_args->file_path, error_message, sizeof(error_message));
+    if (template_pcb)
+    {
+        int clone_count = Process__spawn(template_pcb, spawn_args->count - 1);
+        Process__start(template_pcb);
+        not_created -= 1 + clone_count;
+        if (not_created > 0)
+            Kernel__log_message("ERRO: %s: apenas %d de %d copias criadas", spawn_args->file_path, 1 + clone_count,
+                                spawn_args->count);
+    }
+    else
+    {
+        Kernel__log_message("ERRO: %s", error_message);
+    }
+
+    if (not_created > 0)
+        count_process_load_failures(not_created);
+    free(spawn_args->file_path);
+    free(spawn_args);
+    return NULL;
+}
+
 // Handler para finalização de processo (VERSÃO FINAL E ROBUSTA)
 void *thread_handler_process_finish(void *args)
 {
     Bcp *pcb_to_terminate = (Bcp *)args;
     int must_call_scheduler = 0;
+    int core = pcb_to_terminate->cpu_core;
 
-    // Inicia uma seção crítica para alterar o estado do processo e a lista global
-    pthread_mutex_lock(&pcb_list_mutex);
-
-    // Verifica se o processo que está terminando era o que estava em execução na CPU.
-    if (kernel_instance->running_process == pcb_to_terminate)
+    // Verifica se o processo que está terminando era o que estava em execução no seu núcleo.
+    CPU__lock();
+    if (kernel_instance->running_process[core] == pcb_to_terminate)
     {
-        kernel_instance->running_process = NULL;
+        kernel_instance->running_process[core] = NULL;
         must_call_scheduler = 1; // Marca que o escalonador DEVE ser chamado
     }
+    CPU__unlock();
 
-    // Remove o processo da lista global de BCPs.
-    // A interface agora não o verá mais.
-    remove_from_list(kernel_instance->pcb_list, pcb_to_terminate, compare_pid);
-
-    // Encerra a seção crítica
-    pthread_mutex_unlock(&pcb_list_mutex);
-
-    // Se a CPU ficou ociosa por causa desta finalização, chama o escalonador.
-    // Esta chamada agora ocorre fora da seção crítica para evitar deadlocks.
+    // Se o núcleo ficou ocioso por causa desta finalização, chama o escalonador.
     if (must_call_scheduler)
     {
-        Scheduler__perform_context_switch();
+        Scheduler__perform_context_switch(core);
     }
 
-    // Por fim, libera toda a memória associada ao processo que foi removido.
+    // Por fim, libera toda a memória associada ao processo que terminou.
     release_process_frames(pcb_to_terminate->pid);
-    free(pcb_to_terminate->name_str);
+    count_process_termination();
 
-    Node *instr_node = pcb_to_terminate->instructions_list_ptr->head;
-    while (instr_node != NULL)
+    // Se ainda há um evento de fim de 'exec' pendente para este processo (ele foi
+    // preemptado no meio de um 'exec'), o BCP só é liberado quando esse evento chegar.
+    CPU__lock();
+    pcb_to_terminate->is_finalized = 1;
+    int can_release_now = (pcb_to_terminate->pending_cpu_timers == 0);
+    CPU__unlock();
+
+    if (can_release_now)
     {
-        free(instr_node->data);
-        instr_node = instr_node->next;
+        Process__finish(pcb_to_terminate);
     }
-    destroy_list(pcb_to_terminate->instructions_list_ptr);
-    free(pcb_to_terminate); // Libera o BCP
-
     return NULL;
 }
 
@@ -202,6 +436,8 @@ void *thread_handler_process_finish(void *args)
 void *thread_handler_mem_load_req(void *args)
 {
     Bcp *pcb = (Bcp *)args;
+    // Monta a tabela de páginas com o tamanho calculado na leitura do programa
+    initialize_process_specific_page_table(pcb->pid, pcb->metadata->pages_required);
     // Emula tempo de carregamento de processo na memória
     Clock__schedule_event(150, EVT_MEM_LOAD_FINISH, pcb);
     return NULL;
@@ -211,18 +447,15 @@ void *thread_handler_mem_load_req(void *args)
 void *thread_handler_mem_load_finish(void *args)
 {
     Bcp *pcb = (Bcp *)args;
-    pcb->current_execution_state = PROCESS_STATE_READY;
+    Process__set_state(pcb, PROCESS_STATE_READY);
 
     // Protege a adição à fila de prontos
     pthread_mutex_lock(&kernel_instance->scheduler->ready_queue_mutex);
-    add_to_list(kernel_instance->scheduler->ready_queue, pcb);
+    Scheduler__add_ready_process(pcb, SCHED_ENQUEUE_NEW);
     pthread_mutex_unlock(&kernel_instance->scheduler->ready_queue_mutex);
 
-    // Se a CPU está ociosa, chama o escalonador para iniciar o processo
-    if (kernel_instance->running_process == NULL)
-    {
-        Scheduler__perform_context_switch();
-    }
+    // Se há um núcleo ocioso, o escalonador inicia o processo nele
+    Scheduler__wake_idle_cores();
     return NULL;
 }
 
@@ -230,11 +463,65 @@ void *thread_handler_mem_load_finish(void *args)
 void *thread_handler_cpu_timer_finish(void *args)
 {
     Bcp *pcb = (Bcp *)args;
-    CPU__set_busy(0);
-    // Se o processo ainda está rodando, a CPU continua sua execução
-    if (kernel_instance->running_process == pcb && pcb->current_execution_state == PROCESS_STATE_RUNNING)
+    int must_release_pcb = 0;
+
+    CPU__lock();
+    pcb->pending_cpu_timers--;
+    if (Process__get_state(pcb) == PROCESS_STATE_TERMINATED)
+    {
+        // O processo terminou enquanto este evento estava pendente.
+        must_release_pcb = (pcb->is_finalized && pcb->pending_cpu_timers == 0);
+    }
+    // Se o processo ainda está rodando e o 'exec' atual acabou, a CPU continua sua execução.
+    // Eventos de um 'exec' interrompido por troca de contexto são ignorados.
+    else if (Kernel__is_running(pcb) && Process__get_state(pcb) == PROCESS_STATE_RUNNING &&
+             Clock__get_time() >= pcb->cpu_burst_end_time)
     {
-        CPU__run_process(pcb);
+        pcb->cpu_burst_length = 0; // A rajada terminou inteira
+        CPU__set_busy(pcb, 0);
+    }
+    CPU__unlock();
+
+    if (must_release_pcb)
+    {
+        Process__finish(pcb);
+    }
+    return NULL;
+}
+
+// Handler para o fim do quantum de um processo no meio de uma rajada de CPU. A rajada
+// não tem evento de fim: a troca de contexto guarda o restante e devolve o processo à fila.
+void *thread_handler_process_interrupt(void *args)
+{
+    Bcp *pcb = (Bcp *)args;
+    int must_release_pcb = 0;
+    int must_preempt = 0;
+
+    CPU__lock();
+    pcb->pending_cpu_timers--;
+    if (Process__get_state(pcb) == PROCESS_STATE_TERMINATED)
+    {
+        // O processo terminou enquanto este evento estava pendente.
+        must_release_pcb = (pcb->is_finalized && pcb->pending_cpu_timers == 0);
+    }
+    // Se o processo saiu da CPU depois de agendar a interrupção, ela não vale mais
+    // (ao voltar, ele recebeu uma fatia nova, que ainda não terminou).
+    else if (Kernel__is_running(pcb) && Process__get_state(pcb) == PROCESS_STATE_RUNNING &&
+             Clock__get_time() >= pcb->slice_end_time)
+    {
+        pcb->quantum_expired = 1;
+        must_preempt = 1;
+    }
+    CPU__unlock();
+
+    if (must_preempt)
+    {
+        Scheduler__perform_context_switch(pcb->cpu_core);
+        Scheduler__wake_idle_cores();
+    }
+    if (must_release_pcb)
+    {
+        Process__finish(pcb);
     }
     return NULL;
 }
@@ -243,10 +530,10 @@ void *thread_handler_cpu_timer_finish(void *args)
 void *thread_handler_disk_request(void *args)
 {
     IOArgs *io_args = (IOArgs *)args;
-    io_args->process->current_execution_state = PROCESS_STATE_WAITING;
+    Process__block(io_args->process, METRICS_WAIT_IO);
     IOManager__add_disk_request(io_args->process, io_args->value);
-    Scheduler__perform_context_switch();
-    free(io_args);
+    Scheduler__perform_context_switch(io_args->process->cpu_core);
+    release_io_args(io_args);
     return NULL;
 }
 
@@ -254,14 +541,18 @@ void *thread_handler_disk_request(void *args)
 void *thread_handler_disk_finish(void *args)
 {
     Bcp *pcb = (Bcp *)args;
-    pcb->current_execution_state = PROCESS_STATE_READY;
+    Process__set_state(pcb, PROCESS_STATE_READY);
 
     // Protege a adição à fila de prontos
     pthread_mutex_lock(&kernel_instance->scheduler->ready_queue_mutex);
-    add_to_list(kernel_instance->scheduler->ready_queue, pcb);
+    Scheduler__io_completed(pcb);
+    Scheduler__add_ready_process(pcb, SCHED_ENQUEUE_WAKEUP);
     pthread_mutex_unlock(&kernel_instance->scheduler->ready_queue_mutex);
 
-    Scheduler__perform_context_switch();
+    // O processo volta à fila do seu último núcleo, onde pode preemptar o processo atual;
+    // quem sobrar na fila pode ser roubado por um núcleo ocioso.
+    Scheduler__perform_context_switch(pcb->cpu_core);
+    Scheduler__wake_idle_cores();
     return NULL;
 }
 
@@ -269,10 +560,10 @@ void *thread_handler_disk_finish(void *args)
 void *thread_handler_print_request(void *args)
 {
     IOArgs *io_args = (IOArgs *)args;
-    io_args->process->current_execution_state = PROCESS_STATE_WAITING;
+    Process__block(io_args->process, METRICS_WAIT_IO);
     IOManager__add_printer_request(io_args->process, io_args->value);
-    Scheduler__perform_context_switch();
-    free(io_args);
+    Scheduler__perform_context_switch(io_args->process->cpu_core);
+    release_io_args(io_args);
     return NULL;
 }
 
@@ -280,14 +571,18 @@ void *thread_handler_print_request(void *args)
 void *thread_handler_print_finish(void *args)
 {
     Bcp *pcb = (Bcp *)args;
-    pcb->current_execution_state = PROCESS_STATE_READY;
+    Process__set_state(pcb, PROCESS_STATE_READY);
     
     // Protege a adição à fila de prontos
     pthread_mutex_lock(&kernel_instance->scheduler->ready_queue_mutex);
-    add_to_list(kernel_instance->scheduler->ready_queue, pcb);
+    Scheduler__io_completed(pcb);
+    Scheduler__add_ready_process(pcb, SCHED_ENQUEUE_WAKEUP);
     pthread_mutex_unlock(&kernel_instance->scheduler->ready_queue_mutex);
 
-    Scheduler__perform_context_switch();
+    // O processo volta à fila do seu último núcleo, onde pode preemptar o processo atual;
+    // quem sobrar na fila pode ser roubado por um núcleo ocioso.
+    Scheduler__perform_context_switch(pcb->cpu_core);
+    Scheduler__wake_idle_cores();
     return NULL;
 }
 
@@ -295,11 +590,18 @@ void *thread_handler_print_finish(void *args)
 void *thread_handler_semaphore_p(void *args)
 {
     SemaArgs *s_args = (SemaArgs *)args;
-    if (semaphore_P_operation(s_args->semaphore, s_args->process))
+    int was_blocked = semaphore_P_operation(s_args->semaphore, s_args->process);
+    complete_syscall(s_args->process);
+    if (was_blocked == 1)
+    {
+        Scheduler__perform_context_switch(s_args->process->cpu_core);
+    }
+    else
     {
-        Scheduler__perform_context_switch();
+        // O processo não bloqueou: a CPU segue para a próxima instrução.
+        CPU__set_busy(s_args->process, 0);
     }
-    free(s_args);
+    release_sema_args(s_args);
     return NULL;
 }
 
@@ -308,7 +610,11 @@ void *thread_handler_semaphore_v(void *args)
 {
     SemaArgs *s_args = (SemaArgs *)args;
     semaphore_V_operation(s_args->semaphore);
-    Scheduler__perform_context_switch();
-    free(s_args);
+    complete_syscall(s_args->process);
+    Scheduler__perform_context_switch(s_args->process->cpu_core);
+    Scheduler__wake_idle_cores(); // O processo acordado pode estar na fila de outro núcleo
+    // Se o processo que executou o V continua na CPU, ela segue para a próxima instrução.
+    CPU__set_busy(s_args->process, 0);
+    release_sema_args(s_args);
     return NULL;
 }
\ No newline at end of file
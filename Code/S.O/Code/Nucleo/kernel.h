@@ -5,7 +5,10 @@
 #include <pthread.h>             // Para tipos e funções de threads (pthread_t, pthread_mutex_t, etc.)
 #include "../Ferramentas/list.h" // Estrutura de dados de lista encadeada
 #include "events.h"              // Definições de eventos do sistema (EventType, KernelEvent)
+#include "../Ferramentas/mpsc_queue.h" // Fila sem travas usada como fila de eventos
 #include "../Process/process.h"  // Definição da estrutura de processo (Bcp)
+#include "process_table.h"       // Tabela de processos indexada por PID
+#include "config.h"              // Limite de núcleos da CPU (CONFIG_MAX_CPU_CORES)
 
 // Declarações avançadas (Forward Declarations) para evitar dependência circular de includes.
 // Informa ao compilador que esses tipos existem, sem precisar incluir seus cabeçalhos completos aqui.
@@ -22,9 +25,10 @@ typedef struct Kernel_s
 {
     int proc_id_counter;                 // Contador global para gerar PIDs (Process IDs) únicos.
     struct Scheduler_s *scheduler;       // Ponteiro para a estrutura do escalonador.
-    List *pcb_list;                      // Lista global de todos os processos (BCPs) no sistema.
+    ProcessTable process_table;          // Tabela de todos os processos (BCPs) no sistema.
     List *semaphore_table;               // Lista de todos os semáforos criados.
-    Bcp *running_process;                // Ponteiro para o BCP do processo que está atualmente na CPU.
+    // BCP do processo em execução em cada núcleo da CPU (NULL = núcleo ocioso), protegido pela trava da CPU.
+    Bcp *running_process[CONFIG_MAX_CPU_CORES];
 
     // Mutex para proteger a tabela de semáforos contra acessos concorrentes.
     pthread_mutex_t semaphore_table_mutex;
@@ -33,6 +37,12 @@ typedef struct Kernel_s
     List *scheduler_log;
     // Mutex para proteger a lista de logs.
     pthread_mutex_t scheduler_log_mutex;
+
+    // Contadores de progresso da simulação (protegidos por process_table_mutex).
+    int terminated_process_count;    // Processos finalizados.
+    int failed_process_count;        // Processos que não puderam ser criados (ex: arquivo inválido).
+    pthread_cond_t termination_cond; // Sinalizada sempre que um processo termina ou falha ao carregar.
+    long long dispatched_event_count; // Total de eventos despachados (atualizado atomicamente).
 } Kernel;
 
 // -----------------------------------------------------------------------------
@@ -40,12 +50,11 @@ typedef struct Kernel_s
 // 'extern' indica que estas variáveis são definidas em outro arquivo (kernel.c).
 // -----------------------------------------------------------------------------
 extern Kernel *kernel_instance;        // Instância global e única do kernel.
-extern pthread_mutex_t pcb_list_mutex; // Mutex para proteger a lista global de processos (pcb_list).
+extern pthread_mutex_t process_table_mutex; // Mutex para proteger a tabela de processos (process_table).
 
-// Fila principal de eventos do sistema e seus mecanismos de sincronização.
-extern List *event_queue;                 // Fila de eventos pendentes a serem processados pelo kernel.
-extern pthread_mutex_t event_queue_mutex; // Mutex para proteger a fila de eventos.
-extern pthread_cond_t event_queue_cond;   // Variável de condição para sinalizar quando novos eventos chegam.
+// Fila principal de eventos do sistema: sem travas, com vários produtores
+// (CPU, clock, I/O, UI, handlers) e um único consumidor (Kernel__run_simulation).
+extern MpscQueue event_queue;
 
 // -----------------------------------------------------------------------------
 // Protótipos das funções principais do núcleo.
@@ -61,7 +70,8 @@ void Kernel__initialize();
  * @brief Loop principal de simulação do kernel.
  *
  * Fica continuamente esperando por eventos na 'event_queue', retira-os e
- * despacha cada um para a thread de tratamento apropriada.
+ * repassa cada um ao pool de workers (ver worker_pool.h). Eventos do mesmo
+ * processo são sempre tratados pelo mesmo worker, em ordem FIFO.
  */
 void Kernel__run_simulation();
 
@@ -73,12 +83,67 @@ void Kernel__run_simulation();
  */
 void Kernel__dispatch_event(EventType type, void *data);
 
+/**
+ * @brief Descrição de um evento a despachar em lote (ver Kernel__dispatch_events_batch).
+ */
+typedef struct
+{
+    EventType type;
+    void *data;
+} EventDispatch;
+
+/**
+ * @brief Despacha vários eventos de uma vez, na ordem do vetor.
+ *
+ * Os eventos são encadeados localmente e publicados na 'event_queue' com uma única
+ * operação atômica e no máximo um despertar do consumidor.
+ *
+ * @param events Vetor de eventos a despachar.
+ * @param count  Quantidade de eventos no vetor.
+ */
+void Kernel__dispatch_events_batch(const EventDispatch *events, int count);
+
+/**
+ * @brief Acrescenta uma mensagem (formato printf) ao log do kernel exibido na interface.
+ * Mensagens iniciadas por "ERRO" também são escritas em stderr quando
+ * kernel_config.echo_errors_to_stderr está ativo.
+ */
+void Kernel__log_message(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Retorna 1 se o processo está em execução em seu núcleo da CPU.
+ * Deve ser chamada com a trava da CPU (CPU__lock).
+ */
+int Kernel__is_running(const Bcp *process);
+
+/**
+ * @brief Retorna o PID do processo envolvido em um evento (0 se o evento não
+ * se refere a um processo existente, como EVT_PROCESS_CREATE).
+ */
+int Kernel__get_event_process_id(EventType type, void *data);
+
+/**
+ * @brief Bloqueia a thread chamadora até que 'expected_count' processos tenham
+ * terminado (ou falhado ao carregar).
+ *
+ * Usada pelo modo headless para saber quando a carga de trabalho foi concluída.
+ * A cada 'stall_timeout_ms' milissegundos sem término, verifica se a simulação
+ * ainda progride: se nenhum evento foi despachado no intervalo e não há eventos
+ * agendados, processos prontos ou em execução, nem trabalho em andamento, ela é
+ * considerada parada (ex: deadlock entre semáforos) e a espera termina.
+ *
+ * @return Quantidade de processos encerrados ou que falharam ao carregar ao final da espera.
+ */
+int Kernel__wait_for_terminations(int expected_count, int stall_timeout_ms);
+
 // -----------------------------------------------------------------------------
 // Protótipos dos Handlers de Thread para cada tipo de evento do kernel.
-// Cada uma dessas funções é o ponto de entrada para uma nova thread que tratará
-// um tipo específico de evento, permitindo o processamento concorrente.
+// Cada uma dessas funções é executada por uma thread do pool de workers e trata
+// um tipo específico de evento; eventos de processos diferentes são tratados
+// concorrentemente.
 // -----------------------------------------------------------------------------
 void *thread_handler_process_create(void *args);   // Trata a criação de um novo processo.
+void *thread_handler_process_spawn(void *args);    // Trata a criação de várias cópias de um processo.
 void *thread_handler_process_finish(void *args);   // Trata a finalização de um processo.
 void *thread_handler_semaphore_p(void *args);      // Trata uma operação P (wait) em um semáforo.
 void *thread_handler_semaphore_v(void *args);      // Trata uma operação V (signal) em um semáforo.
@@ -89,5 +154,6 @@ void *thread_handler_print_finish(void *args);     // Trata a conclusão de uma
 void *thread_handler_mem_load_req(void *args);     // Trata a requisição para carregar um processo na memória.
 void *thread_handler_mem_load_finish(void *args);  // Trata a conclusão do carregamento na memória.
 void *thread_handler_cpu_timer_finish(void *args); // Trata o fim de uma fatia de tempo da CPU (quantum).
+void *thread_handler_process_interrupt(void *args); // Trata o fim do quantum no meio de um 'exec'.
 
 #endif // Fim do include guard KERNEL_H_GUARD
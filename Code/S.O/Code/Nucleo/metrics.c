@@ -0,0 +1,170 @@
+#include "metrics.h"
+#include "config.h"
+#include "../Process/process.h"
+#include "../Clock/clock.h"
+#include "../Ferramentas/histogram.h"
+#include <pthread.h>
+
+// -----------------------------------------------------------------------------
+// Agregados do sistema
+// -----------------------------------------------------------------------------
+
+// Métricas resumidas em histogramas (uma entrada por processo concluído)
+typedef enum
+{
+    METRIC_TURNAROUND,
+    METRIC_RESPONSE,
+    METRIC_READY_WAIT,
+    METRIC_CPU_TIME,
+    METRIC_IO_WAIT,
+    METRIC_SEMAPHORE_WAIT,
+    METRIC_COUNT
+} MetricKind;
+
+static Histogram completed_histograms[METRIC_COUNT]; // Protegidos por metrics_mutex
+static long long completed_count = 0;                // Protegido por metrics_mutex
+static pthread_mutex_t metrics_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Tempo de CPU somado de todos os processos (atualizado atomicamente)
+static long long cpu_busy_time = 0;
+
+// Soma o intervalo passado em um estado ao acumulador correspondente
+static void add_state_time(ProcessMetrics *metrics, int state, long long elapsed)
+{
+    switch (state)
+    {
+    case PROCESS_STATE_NEW:
+        metrics->load_time += elapsed;
+        break;
+    case PROCESS_STATE_READY:
+        metrics->ready_time += elapsed;
+        break;
+    case PROCESS_STATE_RUNNING:
+        metrics->cpu_time += elapsed;
+        break;
+    case PROCESS_STATE_WAITING:
+        if (metrics->wait_reason == METRICS_WAIT_SEMAPHORE)
+            metrics->semaphore_wait_time += elapsed;
+        else
+            metrics->io_wait_time += elapsed;
+        break;
+    default:
+        break;
+    }
+}
+
+// Inclui um processo concluído nos agregados do sistema
+static void record_completion(const ProcessMetrics *metrics)
+{
+    pthread_mutex_lock(&metrics_mutex);
+    histogram_record(&completed_histograms[METRIC_TURNAROUND], metrics->finish_time - metrics->arrival_time);
+    histogram_record(&completed_histograms[METRIC_RESPONSE],
+                     (metrics->first_run_time >= 0 ? metrics->first_run_time : metrics->finish_time) -
+                         metrics->arrival_time);
+    histogram_record(&completed_histograms[METRIC_READY_WAIT], metrics->ready_time);
+    histogram_record(&completed_histograms[METRIC_CPU_TIME], metrics->cpu_time);
+    histogram_record(&completed_histograms[METRIC_IO_WAIT], metrics->io_wait_time);
+    histogram_record(&completed_histograms[METRIC_SEMAPHORE_WAIT], metrics->semaphore_wait_time);
+    completed_count++;
+    pthread_mutex_unlock(&metrics_mutex);
+}
+
+// -----------------------------------------------------------------------------
+// Métricas por processo
+// -----------------------------------------------------------------------------
+void Metrics__process_created(ProcessMetrics *metrics)
+{
+    long long now = Clock__get_time();
+    *metrics = (ProcessMetrics){0};
+    metrics->arrival_time = now;
+    metrics->state_since = now;
+    metrics->first_run_time = -1;
+    metrics->finish_time = -1;
+}
+
+void Metrics__record_transition(ProcessMetrics *metrics, int old_state, int new_state)
+{
+    long long now = Clock__get_time();
+    long long elapsed = now - metrics->state_since;
+    add_state_time(metrics, old_state, elapsed);
+    metrics->state_since = now;
+    if (old_state == PROCESS_STATE_RUNNING)
+        __atomic_fetch_add(&cpu_busy_time, elapsed, __ATOMIC_RELAXED);
+
+    if (new_state == PROCESS_STATE_RUNNING && old_state != PROCESS_STATE_RUNNING)
+    {
+        if (metrics->first_run_time < 0)
+            metrics->first_run_time = now;
+        metrics->dispatch_count++;
+    }
+    else if (new_state == PROCESS_STATE_TERMINATED && old_state != PROCESS_STATE_TERMINATED)
+    {
+        metrics->finish_time = now;
+        record_completion(metrics);
+    }
+}
+
+void Metrics__get_process(const Bcp *process, ProcessMetrics *snapshot)
+{
+    *snapshot = process->metrics;
+    int state = Process__get_state(process);
+    if (state != PROCESS_STATE_TERMINATED)
+        add_state_time(snapshot, state, Clock__get_time() - snapshot->state_since);
+}
+
+// -----------------------------------------------------------------------------
+// Métricas do sistema
+// -----------------------------------------------------------------------------
+static void summarize(Histogram *histogram, MetricsSummary *summary)
+{
+    summary->mean = histogram_mean(histogram);
+    summary->p50 = histogram_value_at_percentile(histogram, 50.0);
+    summary->p95 = histogram_value_at_percentile(histogram, 95.0);
+    summary->p99 = histogram_value_at_percentile(histogram, 99.0);
+    summary->max = histogram->max_value;
+}
+
+void Metrics__get_system(SystemMetrics *system)
+{
+    system->virtual_time = Clock__get_time();
+    system->core_count = kernel_config.cpu_core_count;
+    system->cpu_busy_time = __atomic_load_n(&cpu_busy_time, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&metrics_mutex);
+    system->completed_count = completed_count;
+    summarize(&completed_histograms[METRIC_TURNAROUND], &system->turnaround);
+    summarize(&completed_histograms[METRIC_RESPONSE], &system->response);
+    summarize(&completed_histograms[METRIC_READY_WAIT], &system->ready_wait);
+    summarize(&completed_histograms[METRIC_CPU_TIME], &system->cpu_time);
+    summarize(&completed_histograms[METRIC_IO_WAIT], &system->io_wait);
+    summarize(&completed_histograms[METRIC_SEMAPHORE_WAIT], &system->semaphore_wait);
+    pthread_mutex_unlock(&metrics_mutex);
+
+    double capacity = (double)system->virtual_time * system->core_count;
+    system->cpu_utilization = capacity > 0 ? system->cpu_busy_time / capacity : 0.0;
+    system->throughput = system->virtual_time > 0 ? system->completed_count * 1000.0 / system->virtual_time : 0.0;
+}
+
+static void print_summary(FILE *output, const char *label, const MetricsSummary *summary)
+{
+    fprintf(output, "%s: %12.1f / %10lld / %10lld / %10lld / %10lld\n", label, summary->mean, summary->p50,
+            summary->p95, summary->p99, summary->max);
+}
+
+void Metrics__print(FILE *output)
+{
+    SystemMetrics system;
+    Metrics__get_system(&system);
+    fprintf(output, "==> Metricas de escalonamento (tempo virtual)\n");
+    fprintf(output, "Processos concluidos..: %lld\n", system.completed_count);
+    fprintf(output, "Uso da CPU............: %.1f%% (%d nucleo(s))\n", system.cpu_utilization * 100.0,
+            system.core_count);
+    fprintf(output, "Vazao.................: %.3f processos / 1000 unidades\n", system.throughput);
+    fprintf(output, "%-22s: %12s / %10s / %10s / %10s / %10s\n", "Por processo", "media", "p50", "p95", "p99", "max");
+    print_summary(output, "Turnaround............", &system.turnaround);
+    print_summary(output, "Resposta..............", &system.response);
+    print_summary(output, "Espera na fila........", &system.ready_wait);
+    print_summary(output, "CPU...................", &system.cpu_time);
+    print_summary(output, "Espera de E/S.........", &system.io_wait);
+    print_summary(output, "Espera em semaforo....", &system.semaphore_wait);
+}
@@ -0,0 +1,97 @@
+#ifndef METRICS_H_GUARD
+#define METRICS_H_GUARD
+
+#include <stdio.h>
+
+/**
+ * @brief Métricas de escalonamento, em tempo virtual.
+ *
+ * Cada transição de estado de um processo (Process__set_state) fecha o intervalo
+ * passado no estado anterior e o soma ao acumulador correspondente do BCP: carga
+ * na memória (NOVO), espera na fila (PRONTO), CPU (EXECUTANDO) e espera de E/S ou
+ * de semáforo (ESPERANDO, conforme o motivo do bloqueio). Assim, para um processo
+ * concluído, turnaround = carga + fila + CPU + E/S + semáforo.
+ *
+ * Ao terminar, o processo entra nos agregados do sistema: histogramas de cada
+ * métrica, de onde saem médias e percentis, além da utilização da CPU e da vazão.
+ */
+
+struct Bcp_t;
+
+// Motivo de um bloqueio (estado ESPERANDO)
+typedef enum
+{
+    METRICS_WAIT_IO,       // Operação de disco ou impressora
+    METRICS_WAIT_SEMAPHORE // Operação P em semáforo
+} MetricsWaitReason;
+
+// Métricas de um processo, embutidas no BCP. Atualizadas por quem muda o estado do processo.
+typedef struct ProcessMetrics_s
+{
+    long long arrival_time;        // Instante de criação do processo
+    long long first_run_time;      // Instante da primeira eleição (-1 se ainda não executou)
+    long long finish_time;         // Instante do término (-1 se ainda não terminou)
+    long long state_since;         // Instante da última transição de estado
+    long long load_time;           // Tempo no estado NOVO (carga na memória)
+    long long ready_time;          // Tempo na fila de prontos
+    long long cpu_time;            // Tempo em execução
+    long long io_wait_time;        // Tempo bloqueado em E/S
+    long long semaphore_wait_time; // Tempo bloqueado em semáforos
+    int dispatch_count;            // Vezes em que foi eleito
+    MetricsWaitReason wait_reason; // Motivo do bloqueio atual
+} ProcessMetrics;
+
+// Resumo de uma métrica sobre os processos concluídos
+typedef struct
+{
+    double mean;
+    long long p50;
+    long long p95;
+    long long p99;
+    long long max;
+} MetricsSummary;
+
+// Métricas do sistema
+typedef struct
+{
+    long long virtual_time;         // Instante virtual da consulta
+    int core_count;                 // Núcleos da CPU
+    long long completed_count;      // Processos concluídos
+    long long cpu_busy_time;        // Tempo de CPU de todos os processos (trechos já encerrados)
+    double cpu_utilization;         // cpu_busy_time / (virtual_time * núcleos), de 0 a 1
+    double throughput;              // Processos concluídos por 1000 unidades de tempo virtual
+    MetricsSummary turnaround;      // Término - criação
+    MetricsSummary response;        // Primeira eleição - criação
+    MetricsSummary ready_wait;      // Tempo total na fila de prontos
+    MetricsSummary cpu_time;        // Tempo total de CPU
+    MetricsSummary io_wait;         // Tempo total bloqueado em E/S
+    MetricsSummary semaphore_wait;  // Tempo total bloqueado em semáforos
+} SystemMetrics;
+
+/**
+ * @brief Inicia as métricas de um processo recém-criado (estado NOVO).
+ */
+void Metrics__process_created(ProcessMetrics *metrics);
+
+/**
+ * @brief Contabiliza uma transição de estado (chamada por Process__set_state).
+ * Ao entrar em PROCESS_STATE_TERMINATED, o processo entra nos agregados do sistema.
+ */
+void Metrics__record_transition(ProcessMetrics *metrics, int old_state, int new_state);
+
+/**
+ * @brief Copia as métricas de um processo, somando o intervalo em andamento no estado atual.
+ */
+void Metrics__get_process(const struct Bcp_t *process, ProcessMetrics *snapshot);
+
+/**
+ * @brief Calcula as métricas do sistema no instante atual.
+ */
+void Metrics__get_system(SystemMetrics *system);
+
+/**
+ * @brief Imprime as métricas do sistema (resumo do modo headless).
+ */
+void Metrics__print(FILE *output);
+
+#endif // METRICS_H_GUARD
@@ -0,0 +1,252 @@
+#include "process_table.h"
+#include "../Process/process.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PROCESS_TABLE_INITIAL_CAPACITY 64
+
+// Hash multiplicativo (Fibonacci) do PID. PIDs são sequenciais, então o índice
+// fica bem espalhado mesmo com sondagem linear.
+static int pid_bucket(const ProcessTable *table, int pid)
+{
+    return (int)(((uint32_t)pid * 2654435761u) >> 7) & table->pid_index_mask;
+}
+
+// Insere 'slot' no índice de PIDs (a chave é o PID do processo no slot).
+static void pid_index_insert(ProcessTable *table, int slot)
+{
+    int bucket = pid_bucket(table, table->slots[slot].process->pid);
+    while (table->pid_index[bucket] != -1)
+        bucket = (bucket + 1) & table->pid_index_mask;
+    table->pid_index[bucket] = slot;
+}
+
+// Posição do PID no índice, ou -1 se ele não estiver lá.
+static int pid_index_find(const ProcessTable *table, int pid)
+{
+    int bucket = pid_bucket(table, pid);
+    while (table->pid_index[bucket] != -1)
+    {
+        if (table->slots[table->pid_index[bucket]].process->pid == pid)
+            return bucket;
+        bucket = (bucket + 1) & table->pid_index_mask;
+    }
+    return -1;
+}
+
+// Remove a posição 'bucket' do índice, recuando as entradas seguintes da mesma
+// sequência de sondagem (sem marcadores de remoção, a busca continua O(1)).
+static void pid_index_remove(ProcessTable *table, int bucket)
+{
+    int hole = bucket;
+    int current = (bucket + 1) & table->pid_index_mask;
+    while (table->pid_index[current] != -1)
+    {
+        int home = pid_bucket(table, table->slots[table->pid_index[current]].process->pid);
+        // A entrada pode ocupar o buraco se sua posição ideal não estiver entre o buraco e ela.
+        if (((current - home) & table->pid_index_mask) >= ((current - hole) & table->pid_index_mask))
+        {
+            table->pid_index[hole] = table->pid_index[current];
+            hole = current;
+        }
+        current = (current + 1) & table->pid_index_mask;
+    }
+    table->pid_index[hole] = -1;
+}
+
+// Reconstrói o índice com 'size' posições (potência de dois).
+static int pid_index_rebuild(ProcessTable *table, int size)
+{
+    int *index = malloc(sizeof(int) * size);
+    if (index == NULL)
+        return -1;
+    for (int i = 0; i < size; i++)
+        index[i] = -1;
+    free(table->pid_index);
+    table->pid_index = index;
+    table->pid_index_mask = size - 1;
+    for (int slot = table->first; slot != -1; slot = table->slots[slot].next)
+        pid_index_insert(table, slot);
+    return 0;
+}
+
+void ProcessTable__init(ProcessTable *table)
+{
+    table->slots = NULL;
+    table->capacity = 0;
+    table->used = 0;
+    table->count = 0;
+    table->free_head = -1;
+    table->first = -1;
+    table->last = -1;
+    table->pid_index = NULL;
+    table->pid_index_mask = 0;
+    memset(table->hot_chunks, 0, sizeof(table->hot_chunks));
+}
+
+void ProcessTable__destroy(ProcessTable *table)
+{
+    free(table->slots);
+    free(table->pid_index);
+    for (int chunk = 0; chunk < PROCESS_TABLE_MAX_CHUNKS; chunk++)
+        free(table->hot_chunks[chunk]);
+    ProcessTable__init(table);
+}
+
+ProcessHandle ProcessTable__insert(ProcessTable *table, Bcp *process)
+{
+    ProcessHandle handle = {0, 0};
+
+    // O índice de PIDs fica no máximo meio cheio.
+    if ((table->count + 1) * 2 > table->pid_index_mask + 1 || table->pid_index == NULL)
+    {
+        int size = table->pid_index == NULL ? PROCESS_TABLE_INITIAL_CAPACITY * 2 : (table->pid_index_mask + 1) * 2;
+        if (pid_index_rebuild(table, size) != 0)
+            return handle;
+    }
+
+    int slot = table->free_head;
+    if (slot != -1)
+    {
+        table->free_head = table->slots[slot].next;
+    }
+    else
+    {
+        if (table->used == PROCESS_TABLE_MAX_CHUNKS * PROCESS_HOT_CHUNK_SIZE)
+            return handle; // Tabela cheia
+        int chunk = table->used >> PROCESS_HOT_CHUNK_SHIFT;
+        if (table->hot_chunks[chunk] == NULL)
+        {
+            table->hot_chunks[chunk] = malloc(sizeof(ProcessHotChunk));
+            if (table->hot_chunks[chunk] == NULL)
+                return handle;
+        }
+        if (table->used == table->capacity)
+        {
+            int capacity = table->capacity == 0 ? PROCESS_TABLE_INITIAL_CAPACITY : table->capacity * 2;
+            ProcessSlot *grown = realloc(table->slots, sizeof(ProcessSlot) * capacity);
+            if (grown == NULL)
+                return handle;
+            table->slots = grown;
+            table->capacity = capacity;
+        }
+        slot = table->used++;
+        table->slots[slot].generation = 1;
+    }
+
+    ProcessSlot *entry = &table->slots[slot];
+    entry->process = process;
+    entry->previous = table->last;
+    entry->next = -1;
+    if (table->last != -1)
+        table->slots[table->last].next = slot;
+    else
+        table->first = slot;
+    table->last = slot;
+    table->count++;
+    pid_index_insert(table, slot);
+
+    // Campos quentes nas colunas do slot
+    ProcessHotChunk *hot = ProcessTable__hot_chunk(table, slot);
+    int hot_index = slot & PROCESS_HOT_CHUNK_MASK;
+    hot->state[hot_index] = PROCESS_STATE_NEW;
+    hot->io_ops[hot_index] = 0;
+    hot->pid[hot_index] = process->pid;
+    hot->priority[hot_index] = process->program->priority_level;
+    hot->ready_position[hot_index] = -1;
+    hot->process[hot_index] = process;
+    process->hot = hot;
+    process->hot_index = hot_index;
+
+    handle.slot = (uint32_t)slot;
+    handle.generation = entry->generation;
+    process->table_handle = handle;
+    return handle;
+}
+
+// Slot referenciado pelo handle, ou NULL se o handle não for mais válido.
+static ProcessSlot *resolve(const ProcessTable *table, ProcessHandle handle)
+{
+    if (handle.slot >= (uint32_t)table->used)
+        return NULL;
+    ProcessSlot *entry = &table->slots[handle.slot];
+    if (entry->process == NULL || entry->generation != handle.generation)
+        return NULL;
+    return entry;
+}
+
+int ProcessTable__remove(ProcessTable *table, ProcessHandle handle)
+{
+    ProcessSlot *entry = resolve(table, handle);
+    if (entry == NULL)
+        return 0;
+
+    pid_index_remove(table, pid_index_find(table, entry->process->pid));
+    if (entry->previous != -1)
+        table->slots[entry->previous].next = entry->next;
+    else
+        table->first = entry->next;
+    if (entry->next != -1)
+        table->slots[entry->next].previous = entry->previous;
+    else
+        table->last = entry->previous;
+
+    ProcessHotChunk *hot = ProcessTable__hot_chunk(table, (int)handle.slot);
+    hot->state[handle.slot & PROCESS_HOT_CHUNK_MASK] = PROCESS_SLOT_FREE;
+    hot->process[handle.slot & PROCESS_HOT_CHUNK_MASK] = NULL;
+    entry->process = NULL;
+    entry->generation++; // Handles antigos deste slot deixam de valer
+    entry->next = table->free_head;
+    table->free_head = (int)handle.slot;
+    table->count--;
+    return 1;
+}
+
+Bcp *ProcessTable__get(const ProcessTable *table, ProcessHandle handle)
+{
+    ProcessSlot *entry = resolve(table, handle);
+    return entry ? entry->process : NULL;
+}
+
+Bcp *ProcessTable__find_pid(const ProcessTable *table, int pid)
+{
+    if (table->pid_index == NULL)
+        return NULL;
+    int bucket = pid_index_find(table, pid);
+    return bucket == -1 ? NULL : table->slots[table->pid_index[bucket]].process;
+}
+
+Bcp *ProcessTable__first(const ProcessTable *table)
+{
+    return table->first == -1 ? NULL : table->slots[table->first].process;
+}
+
+Bcp *ProcessTable__next(const ProcessTable *table, const Bcp *current)
+{
+    ProcessSlot *entry = resolve(table, current->table_handle);
+    if (entry == NULL || entry->next == -1)
+        return NULL;
+    return table->slots[entry->next].process;
+}
+
+int ProcessTable__count(const ProcessTable *table)
+{
+    return table->count;
+}
+
+void ProcessTable__count_states(const ProcessTable *table, int *counts, int state_count)
+{
+    for (int state = 0; state < state_count; state++)
+        counts[state] = 0;
+    // Uma passada sequencial pela coluna de estados de cada bloco.
+    for (int base = 0; base < table->used; base += PROCESS_HOT_CHUNK_SIZE)
+    {
+        const unsigned char *states = ProcessTable__hot_chunk(table, base)->state;
+        int limit = table->used - base < PROCESS_HOT_CHUNK_SIZE ? table->used - base : PROCESS_HOT_CHUNK_SIZE;
+        for (int i = 0; i < limit; i++)
+        {
+            if (states[i] < state_count)
+                counts[states[i]]++;
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef PROCESS_TABLE_H_GUARD
+#define PROCESS_TABLE_H_GUARD
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Tabela de processos do kernel.
+//
+// Os BCPs vivos ficam em um vetor de slots que cresce por dobra; slots livres
+// formam uma lista e são reaproveitados. Cada slot tem uma geração, incrementada
+// quando ele é liberado: um handle (slot + geração) de um processo que já saiu da
+// tabela é reconhecido como inválido, mesmo que o slot tenha sido reutilizado.
+//
+// Inserção, remoção e busca por handle ou por PID custam O(1). Os slots ocupados
+// são encadeados na ordem de inserção, para que a interface os percorra sempre na
+// mesma ordem (a de criação dos processos). A tabela não é thread-safe: quem a
+// usa deve segurar process_table_mutex.
+//
+// Os campos consultados a todo momento pelo escalonador (estado, E/S, PID,
+// prioridade e posição na fila de prontos) ficam fora do BCP, em colunas contíguas indexadas pelo slot. As
+// colunas são alocadas em blocos de tamanho fixo que nunca mudam de lugar: o BCP
+// guarda o endereço do seu bloco, e o escalonador as lê sem a trava da tabela.
+// -----------------------------------------------------------------------------
+
+struct Bcp_t;
+
+#define PROCESS_HOT_CHUNK_SHIFT 10
+#define PROCESS_HOT_CHUNK_SIZE (1 << PROCESS_HOT_CHUNK_SHIFT) // Slots por bloco de colunas
+#define PROCESS_HOT_CHUNK_MASK (PROCESS_HOT_CHUNK_SIZE - 1)
+#define PROCESS_TABLE_MAX_CHUNKS 4096                           // Até 4M processos vivos
+#define PROCESS_SLOT_FREE 0xFF                                  // Estado de um slot sem processo
+
+// Bloco de colunas dos campos quentes de PROCESS_HOT_CHUNK_SIZE slots consecutivos
+typedef struct ProcessHotChunk_t
+{
+    unsigned char state[PROCESS_HOT_CHUNK_SIZE];      // ProcessCurrentState (ou PROCESS_SLOT_FREE)
+    int io_ops[PROCESS_HOT_CHUNK_SIZE];               // Operações de disco (leitura + escrita) realizadas
+    int pid[PROCESS_HOT_CHUNK_SIZE];                  // PID
+    int priority[PROCESS_HOT_CHUNK_SIZE];             // Prioridade (a do programa do processo)
+    int ready_position[PROCESS_HOT_CHUNK_SIZE];       // Posição na fila de prontos (-1 = fora dela)
+    struct Bcp_t *process[PROCESS_HOT_CHUNK_SIZE];    // BCP do slot (para quem percorre as colunas)
+} ProcessHotChunk;
+
+// Referência a um processo na tabela
+typedef struct
+{
+    uint32_t slot;       // Posição no vetor de slots
+    uint32_t generation; // Geração do slot quando o processo foi inserido (0 = handle nulo)
+} ProcessHandle;
+
+typedef struct
+{
+    struct Bcp_t *process; // Processo no slot (NULL se livre)
+    uint32_t generation;   // Geração atual do slot
+    int previous;          // Slot ocupado anterior na ordem de inserção (-1 = nenhum)
+    int next;              // Próximo slot ocupado na ordem de inserção, ou próximo livre
+} ProcessSlot;
+
+typedef struct
+{
+    ProcessSlot *slots; // Vetor de slots
+    int capacity;       // Slots alocados
+    int used;           // Slots já entregues alguma vez (os demais nunca foram usados)
+    int count;          // Processos na tabela
+    int free_head;      // Primeiro slot livre reaproveitável (-1 = nenhum)
+    int first;          // Slot ocupado mais antigo (-1 = tabela vazia)
+    int last;           // Slot ocupado mais recente
+    int *pid_index;     // Índice aberto PID -> slot (-1 = posição vazia)
+    int pid_index_mask; // Tamanho do índice - 1 (potência de dois)
+    ProcessHotChunk *hot_chunks[PROCESS_TABLE_MAX_CHUNKS]; // Colunas dos campos quentes (alocadas sob demanda)
+} ProcessTable;
+
+/**
+ * @brief Bloco de colunas que contém um slot (o índice no bloco é slot & PROCESS_HOT_CHUNK_MASK).
+ */
+static inline ProcessHotChunk *ProcessTable__hot_chunk(const ProcessTable *table, int slot)
+{
+    return table->hot_chunks[slot >> PROCESS_HOT_CHUNK_SHIFT];
+}
+
+/**
+ * @brief Inicializa uma tabela vazia.
+ */
+void ProcessTable__init(ProcessTable *table);
+
+/**
+ * @brief Libera a memória da tabela (não os BCPs).
+ */
+void ProcessTable__destroy(ProcessTable *table);
+
+/**
+ * @brief Insere um processo, grava seu handle em process->table_handle e aponta
+ * process->hot para as colunas do slot (estado inicial: PROCESS_STATE_NEW;
+ * a prioridade é copiada de process->program).
+ * @return Handle do processo, ou um handle nulo se faltar memória ou a tabela estiver cheia.
+ */
+ProcessHandle ProcessTable__insert(ProcessTable *table, struct Bcp_t *process);
+
+/**
+ * @brief Remove o processo referenciado pelo handle.
+ * @return 1 se removeu, 0 se o handle já não era válido.
+ */
+int ProcessTable__remove(ProcessTable *table, ProcessHandle handle);
+
+/**
+ * @brief Retorna o processo referenciado pelo handle, ou NULL se ele já saiu da tabela.
+ */
+struct Bcp_t *ProcessTable__get(const ProcessTable *table, ProcessHandle handle);
+
+/**
+ * @brief Busca um processo pelo PID. Retorna NULL se não houver processo vivo com esse PID.
+ */
+struct Bcp_t *ProcessTable__find_pid(const ProcessTable *table, int pid);
+
+/**
+ * @brief Iteração na ordem de inserção: primeiro processo e o seguinte a 'current'.
+ * Retornam NULL ao fim da tabela.
+ */
+struct Bcp_t *ProcessTable__first(const ProcessTable *table);
+struct Bcp_t *ProcessTable__next(const ProcessTable *table, const struct Bcp_t *current);
+
+/**
+ * @brief Quantidade de processos na tabela.
+ */
+int ProcessTable__count(const ProcessTable *table);
+
+/**
+ * @brief Conta os processos em cada estado, percorrendo a coluna de estados.
+ * @param counts Recebe, em counts[estado], a quantidade de processos (estados < state_count).
+ */
+void ProcessTable__count_states(const ProcessTable *table, int *counts, int state_count);
+
+#endif // PROCESS_TABLE_H_GUARD
@@ -0,0 +1,58 @@
+#include "thread_stats.h"
+#include <pthread.h>
+#include <time.h>
+
+#define MAX_REGISTERED_THREADS 256
+
+// Threads registradas. As threads do simulador nunca terminam, então seus
+// identificadores continuam válidos para consultar o relógio de CPU.
+typedef struct
+{
+    pthread_t thread_id;
+    Subsystem subsystem;
+} RegisteredThread;
+
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+static RegisteredThread registered_threads[MAX_REGISTERED_THREADS];
+static int registered_count = 0;
+
+static const char *subsystem_names[SUBSYSTEM_COUNT] = {"kernel_loop", "workers", "clock", "cpu", "io"};
+
+void ThreadStats__register_current(Subsystem subsystem)
+{
+    pthread_mutex_lock(&registry_mutex);
+    if (registered_count < MAX_REGISTERED_THREADS)
+    {
+        registered_threads[registered_count].thread_id = pthread_self();
+        registered_threads[registered_count].subsystem = subsystem;
+        registered_count++;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+double ThreadStats__get_cpu_seconds(Subsystem subsystem)
+{
+    double total_seconds = 0.0;
+    pthread_mutex_lock(&registry_mutex);
+    for (int i = 0; i < registered_count; i++)
+    {
+        if (registered_threads[i].subsystem != subsystem)
+            continue;
+        clockid_t cpu_clock;
+        struct timespec cpu_time;
+        if (pthread_getcpuclockid(registered_threads[i].thread_id, &cpu_clock) == 0 &&
+            clock_gettime(cpu_clock, &cpu_time) == 0)
+        {
+            total_seconds += (double)cpu_time.tv_sec + (double)cpu_time.tv_nsec / 1e9;
+        }
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    return total_seconds;
+}
+
+const char *ThreadStats__get_subsystem_name(Subsystem subsystem)
+{
+    if (subsystem < 0 || subsystem >= SUBSYSTEM_COUNT)
+        return "desconhecido";
+    return subsystem_names[subsystem];
+}
@@ -0,0 +1,34 @@
+#ifndef THREAD_STATS_H_GUARD
+#define THREAD_STATS_H_GUARD
+
+/**
+ * @brief Subsistemas do simulador, para contabilizar o tempo de CPU real de suas threads.
+ */
+typedef enum
+{
+    SUBSYSTEM_KERNEL_LOOP, // Laço principal do kernel (Kernel__run_simulation)
+    SUBSYSTEM_WORKERS,     // Workers que tratam os eventos (inclui o escalonador)
+    SUBSYSTEM_CLOCK,       // Thread do clock virtual
+    SUBSYSTEM_CPU,         // Thread da CPU simulada
+    SUBSYSTEM_IO,          // Threads de disco e impressora
+    SUBSYSTEM_COUNT
+} Subsystem;
+
+/**
+ * @brief Registra a thread atual como pertencente a um subsistema.
+ * Deve ser chamada no início da função de cada thread de longa duração.
+ */
+void ThreadStats__register_current(Subsystem subsystem);
+
+/**
+ * @brief Retorna o tempo de CPU real (em segundos) consumido até agora pelas
+ * threads registradas de um subsistema.
+ */
+double ThreadStats__get_cpu_seconds(Subsystem subsystem);
+
+/**
+ * @brief Nome curto de um subsistema (ex: "clock").
+ */
+const char *ThreadStats__get_subsystem_name(Subsystem subsystem);
+
+#endif // THREAD_STATS_H_GUARD
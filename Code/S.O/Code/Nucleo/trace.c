@@ -0,0 +1,178 @@
+#include "trace.h"
+#include "config.h"
+#include "../Ferramentas/histogram.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TRACE_RING_CAPACITY 4096   // Registros por buffer (potência de dois)
+#define TRACE_RING_HIGH_WATER 3072 // Ocupação a partir da qual a própria thread esvazia os buffers
+
+// Fases medidas para cada evento
+typedef enum
+{
+    TRACE_STAGE_KERNEL_QUEUE, // Espera na fila do kernel
+    TRACE_STAGE_WORKER_QUEUE, // Espera na fila do worker
+    TRACE_STAGE_HANDLER,      // Execução do handler
+    TRACE_STAGE_TOTAL,        // Do despacho ao fim do handler
+    TRACE_STAGE_COUNT
+} TraceStage;
+
+static const char *stage_names[TRACE_STAGE_COUNT] = {"fila kernel", "fila worker", "handler", "total"};
+
+// Registro de um evento tratado
+typedef struct
+{
+    EventType type;
+    long long enqueue_ns;
+    long long dequeue_ns;
+    long long handler_start_ns;
+    long long handler_end_ns;
+} TraceRecord;
+
+// Buffer circular de uma thread: um produtor (a própria thread) e um consumidor
+// (quem detém trace_mutex). 'head' só é escrito pelo produtor e 'tail', pelo consumidor.
+typedef struct TraceRing_t
+{
+    TraceRecord records[TRACE_RING_CAPACITY];
+    unsigned long long head;     // Próxima posição a escrever
+    unsigned long long tail;     // Próxima posição a ler
+    long long dropped_count;     // Registros descartados com o buffer cheio
+    struct TraceRing_t *next_ring;
+} TraceRing;
+
+static __thread TraceRing *thread_ring = NULL;
+
+// Protege a lista de buffers, o consumo deles e os histogramas
+static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static TraceRing *registered_rings = NULL;
+static Histogram stage_histograms[EVT_TYPE_COUNT][TRACE_STAGE_COUNT];
+
+int Trace__is_enabled()
+{
+    return kernel_config.trace_enabled;
+}
+
+long long Trace__now_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// Move os registros pendentes de todos os buffers para os histogramas.
+// Deve ser chamada com trace_mutex travado.
+static void drain_rings()
+{
+    for (TraceRing *ring = registered_rings; ring != NULL; ring = ring->next_ring)
+    {
+        unsigned long long head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        unsigned long long tail = ring->tail;
+        while (tail != head)
+        {
+            TraceRecord *record = &ring->records[tail & (TRACE_RING_CAPACITY - 1)];
+            if (record->type >= 0 && record->type < EVT_TYPE_COUNT)
+            {
+                Histogram *histograms = stage_histograms[record->type];
+                histogram_record(&histograms[TRACE_STAGE_KERNEL_QUEUE], record->dequeue_ns - record->enqueue_ns);
+                histogram_record(&histograms[TRACE_STAGE_WORKER_QUEUE], record->handler_start_ns - record->dequeue_ns);
+                histogram_record(&histograms[TRACE_STAGE_HANDLER], record->handler_end_ns - record->handler_start_ns);
+                histogram_record(&histograms[TRACE_STAGE_TOTAL], record->handler_end_ns - record->enqueue_ns);
+            }
+            tail++;
+        }
+        // Libera as posições lidas para o produtor
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+}
+
+// Retorna o buffer da thread atual, criando-o no primeiro uso
+static TraceRing *get_thread_ring()
+{
+    if (__builtin_expect(thread_ring == NULL, 0))
+    {
+        TraceRing *new_ring = calloc(1, sizeof(TraceRing));
+        if (new_ring == NULL)
+            return NULL;
+        pthread_mutex_lock(&trace_mutex);
+        new_ring->next_ring = registered_rings;
+        registered_rings = new_ring;
+        pthread_mutex_unlock(&trace_mutex);
+        thread_ring = new_ring;
+    }
+    return thread_ring;
+}
+
+void Trace__record_event(const KernelEvent *event, long long handler_start_ns, long long handler_end_ns)
+{
+    TraceRing *ring = get_thread_ring();
+    if (ring == NULL)
+        return;
+
+    unsigned long long head = ring->head;
+    unsigned long long tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= TRACE_RING_CAPACITY)
+    {
+        // Buffer cheio: o registro é descartado em vez de bloquear o worker
+        __atomic_store_n(&ring->dropped_count, ring->dropped_count + 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    TraceRecord *record = &ring->records[head & (TRACE_RING_CAPACITY - 1)];
+    record->type = event->type;
+    record->enqueue_ns = event->enqueue_ns;
+    record->dequeue_ns = event->dequeue_ns;
+    record->handler_start_ns = handler_start_ns;
+    record->handler_end_ns = handler_end_ns;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE); // Publica o registro
+
+    // Acima da marca de ocupação, a própria thread esvazia os buffers. Se outra
+    // thread já estiver fazendo isso, segue sem esperar.
+    if (head + 1 - tail >= TRACE_RING_HIGH_WATER && pthread_mutex_trylock(&trace_mutex) == 0)
+    {
+        drain_rings();
+        pthread_mutex_unlock(&trace_mutex);
+    }
+}
+
+void Trace__dump(FILE *output)
+{
+    pthread_mutex_lock(&trace_mutex);
+    drain_rings();
+
+    long long dropped_total = 0;
+    for (TraceRing *ring = registered_rings; ring != NULL; ring = ring->next_ring)
+    {
+        dropped_total += __atomic_load_n(&ring->dropped_count, __ATOMIC_RELAXED);
+    }
+
+    fprintf(output, "==> Latencia dos eventos do kernel (us: p50 / p99 / max)\n");
+    fprintf(output, "%-22s %8s", "Tipo", "Qtd");
+    for (int stage = 0; stage < TRACE_STAGE_COUNT; stage++)
+    {
+        fprintf(output, " | %-28s", stage_names[stage]);
+    }
+    fprintf(output, "\n");
+
+    for (int type = 0; type < EVT_TYPE_COUNT; type++)
+    {
+        Histogram *histograms = stage_histograms[type];
+        if (histograms[TRACE_STAGE_TOTAL].total_count == 0)
+            continue;
+        fprintf(output, "%-22s %8lld", event_type_name((EventType)type), histograms[TRACE_STAGE_TOTAL].total_count);
+        for (int stage = 0; stage < TRACE_STAGE_COUNT; stage++)
+        {
+            Histogram *histogram = &histograms[stage];
+            fprintf(output, " | %8.1f / %7.1f / %7.1f",
+                    histogram_value_at_percentile(histogram, 50.0) / 1000.0,
+                    histogram_value_at_percentile(histogram, 99.0) / 1000.0,
+                    histogram->max_value / 1000.0);
+        }
+        fprintf(output, "\n");
+    }
+    if (dropped_total > 0)
+    {
+        fprintf(output, "AVISO: %lld registro(s) descartado(s) com buffers cheios.\n", dropped_total);
+    }
+    pthread_mutex_unlock(&trace_mutex);
+}
@@ -0,0 +1,43 @@
+#ifndef TRACE_H_GUARD
+#define TRACE_H_GUARD
+
+#include <stdio.h>
+#include "events.h"
+
+/**
+ * @brief Rastreamento de latência dos eventos do kernel (ativado com --trace).
+ *
+ * Para cada evento tratado, registra quatro instantes reais: entrada na fila do
+ * kernel, saída dela, início e fim do handler. Cada thread de worker escreve em
+ * seu próprio buffer circular sem travas; os buffers são esvaziados em
+ * histogramas log-linear por tipo de evento quando passam da marca de
+ * ocupação, e também a cada relatório.
+ *
+ * Fases medidas: fila do kernel (dequeue - enqueue), fila do worker
+ * (início - dequeue), handler (fim - início) e total (fim - enqueue).
+ */
+
+/**
+ * @brief Retorna 1 se o rastreamento está ativo.
+ */
+int Trace__is_enabled();
+
+/**
+ * @brief Instante real atual, em nanossegundos (CLOCK_MONOTONIC).
+ */
+long long Trace__now_ns();
+
+/**
+ * @brief Registra o tratamento de um evento no buffer da thread atual.
+ * @param event            Evento tratado (com enqueue_ns e dequeue_ns preenchidos).
+ * @param handler_start_ns Instante de início do handler.
+ * @param handler_end_ns   Instante de fim do handler.
+ */
+void Trace__record_event(const KernelEvent *event, long long handler_start_ns, long long handler_end_ns);
+
+/**
+ * @brief Esvazia os buffers e imprime os percentis de latência por tipo de evento.
+ */
+void Trace__dump(FILE *output);
+
+#endif // TRACE_H_GUARD
@@ -0,0 +1,75 @@
+#include "worker_pool.h"
+#include "../Ferramentas/list.h"
+#include "thread_stats.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+// Estado de cada worker: fila própria de eventos e sua sincronização.
+typedef struct
+{
+    List *event_fifo;           // Eventos aguardando tratamento, em ordem de chegada
+    pthread_mutex_t fifo_mutex; // Protege a fila
+    pthread_cond_t fifo_cond;   // Sinaliza a chegada de um evento
+    pthread_t thread_id;
+} Worker;
+
+static Worker *workers = NULL;
+static int pool_size = 0;
+static void (*event_handler)(KernelEvent *event) = NULL;
+
+// Laço de cada worker: retira eventos da própria fila e os trata em ordem.
+static void *worker_thread_runner(void *args)
+{
+    Worker *self = (Worker *)args;
+    ThreadStats__register_current(SUBSYSTEM_WORKERS);
+    while (1)
+    {
+        pthread_mutex_lock(&self->fifo_mutex);
+        while (self->event_fifo->size == 0)
+        {
+            pthread_cond_wait(&self->fifo_cond, &self->fifo_mutex);
+        }
+        KernelEvent *event = (KernelEvent *)remove_first_from_list(self->event_fifo);
+        pthread_mutex_unlock(&self->fifo_mutex);
+
+        event_handler(event);
+        release_kernel_event(event);
+    }
+    return NULL;
+}
+
+void WorkerPool__initialize(int worker_count, void (*handle_event)(KernelEvent *event))
+{
+    if (worker_count < 1)
+        worker_count = 1;
+    event_handler = handle_event;
+    workers = malloc(sizeof(Worker) * worker_count);
+    if (workers == NULL)
+    {
+        exit(1);
+    }
+    pool_size = worker_count;
+
+    for (int i = 0; i < worker_count; i++)
+    {
+        workers[i].event_fifo = create_list();
+        pthread_mutex_init(&workers[i].fifo_mutex, NULL);
+        pthread_cond_init(&workers[i].fifo_cond, NULL);
+        pthread_create(&workers[i].thread_id, NULL, worker_thread_runner, &workers[i]);
+        pthread_detach(workers[i].thread_id);
+    }
+}
+
+void WorkerPool__submit(KernelEvent *event, unsigned int affinity_key)
+{
+    Worker *target = &workers[affinity_key % pool_size];
+    pthread_mutex_lock(&target->fifo_mutex);
+    add_to_list(target->event_fifo, event);
+    pthread_cond_signal(&target->fifo_cond);
+    pthread_mutex_unlock(&target->fifo_mutex);
+}
+
+int WorkerPool__get_worker_count()
+{
+    return pool_size;
+}
@@ -0,0 +1,32 @@
+#ifndef WORKER_POOL_H_GUARD
+#define WORKER_POOL_H_GUARD
+
+#include "events.h"
+
+/**
+ * @brief Pool fixo de threads que tratam os eventos do kernel.
+ *
+ * Cada worker tem sua própria fila FIFO. Eventos com a mesma chave de afinidade
+ * (o PID do processo envolvido) vão sempre para o mesmo worker, de modo que os
+ * eventos de um processo são tratados um de cada vez e na ordem de chegada.
+ */
+
+/**
+ * @brief Cria as threads do pool. Deve ser chamada uma única vez.
+ * @param worker_count Quantidade de threads.
+ * @param handle_event Função que trata um evento (chamada pela thread do worker).
+ */
+void WorkerPool__initialize(int worker_count, void (*handle_event)(KernelEvent *event));
+
+/**
+ * @brief Enfileira um evento para o worker responsável pela chave informada.
+ * O pool assume a posse do evento e o libera após o tratamento.
+ */
+void WorkerPool__submit(KernelEvent *event, unsigned int affinity_key);
+
+/**
+ * @brief Retorna a quantidade de threads do pool.
+ */
+int WorkerPool__get_worker_count();
+
+#endif // WORKER_POOL_H_GUARD
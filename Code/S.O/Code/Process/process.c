@@ -5,22 +5,67 @@
 #include "../escalonador/scheduler.h"
 #include "../CPU/cpu.h"
 #include "../Clock/clock.h"
+#include "../Nucleo/config.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Define um Kbyte como 1024, para conversões de tamanho de segmento.
-#ifndef KBYTE_DEF
-#define KBYTE_DEF 1024
-#endif
+// -----------------------------------------------------------------------------
+// Blocos 'repeat': a pilha de repetições restantes fica no BCP e o marcador de fim
+// guarda o índice do início, então o corpo é executado N vezes sem ser copiado.
+// -----------------------------------------------------------------------------
+static void advance_over_loop_markers(Bcp *target_bcp)
+{
+    while (target_bcp->program_counter_val < target_bcp->instruction_count)
+    {
+        const Instruction *marker = &target_bcp->instructions[target_bcp->program_counter_val];
+        if (marker->op_code_val == OP_CODE_REPEAT)
+        {
+            target_bcp->loop_remaining[target_bcp->loop_depth++] = marker->value_operand;
+            target_bcp->program_counter_val++;
+        }
+        else if (marker->op_code_val == OP_CODE_END_REPEAT)
+        {
+            if (--target_bcp->loop_remaining[target_bcp->loop_depth - 1] > 0)
+            {
+                target_bcp->program_counter_val = marker->value_operand + 1; // Volta ao início do corpo
+            }
+            else
+            {
+                target_bcp->loop_depth--;
+                target_bcp->program_counter_val++;
+            }
+        }
+        else
+        {
+            return;
+        }
+    }
+}
 
 // -----------------------------------------------------------------------------
-// Protótipos das funções auxiliares de parsing de arquivo de processo sintético.
-// Essas funções são usadas internamente por este módulo.
+// Inicia uma rajada de CPU de 'exec_time' unidades ('length' 'exec's a partir de
+// 'start_pc'). Com quantum, uma rajada que passa do fim da fatia do processo não
+// agenda seu evento de fim: é cortada por um EVT_PROCESS_INTERRUPT no fim da fatia.
 // -----------------------------------------------------------------------------
-Instruction *parse_instruction_from_string(char *instruction_line);
-List *read_synthetic_file_instructions(FILE *fp);
-void translate_string_to_opcode(Instruction *instruction_ptr, char *opcode_string);
+static void start_cpu_burst(Bcp *active_process_bcp, long long exec_time, int start_pc, int length)
+{
+    CPU__set_busy(active_process_bcp, 1); // Trava a CPU, indicando que está ocupada.
+    active_process_bcp->pending_cpu_timers++;
+    active_process_bcp->cpu_burst_start_pc = start_pc;
+    active_process_bcp->cpu_burst_length = length;
+
+    long long now = Clock__get_time();
+    if (kernel_config.quantum > 0 && now + exec_time > active_process_bcp->slice_end_time)
+    {
+        long long slice_left = active_process_bcp->slice_end_time > now ? active_process_bcp->slice_end_time - now : 0;
+        long long interrupt_time = Clock__schedule_event(slice_left, EVT_PROCESS_INTERRUPT, active_process_bcp);
+        active_process_bcp->cpu_burst_end_time = interrupt_time - slice_left + exec_time;
+        return;
+    }
+    // Agenda um evento para destravar a CPU após o tempo de execução.
+    active_process_bcp->cpu_burst_end_time = Clock__schedule_event(exec_time, EVT_CPU_TIMER_FINISH, active_process_bcp);
+}
 
 // -----------------------------------------------------------------------------
 // Função principal de execução de instrução do processo.
@@ -29,35 +74,38 @@ void translate_string_to_opcode(Instruction *instruction_ptr, char *opcode_strin
 void execute_current_process_instruction(Bcp *active_process_bcp)
 {
     // Validação: Garante que o processo existe e está no estado de 'EXECUTANDO'.
-    if (!active_process_bcp || active_process_bcp->current_execution_state != PROCESS_STATE_RUNNING)
+    if (!active_process_bcp || Process__get_state(active_process_bcp) != PROCESS_STATE_RUNNING)
     {
         return; // Se não for válido, não faz nada.
     }
 
-    // Verifica se o processo terminou (se o contador de programa ultrapassou o número de instruções).
-    if (active_process_bcp->program_counter_val >= active_process_bcp->instructions_list_ptr->size)
+    // Um 'exec' cortado pelo fim do quantum termina antes da próxima instrução.
+    if (active_process_bcp->remaining_exec_time > 0)
     {
-        // Se terminou, despacha um evento de finalização para o kernel.
-        Kernel__dispatch_event(EVT_PROCESS_FINISH, active_process_bcp);
+        long long remaining_time = active_process_bcp->remaining_exec_time;
+        active_process_bcp->remaining_exec_time = 0;
+        start_cpu_burst(active_process_bcp, remaining_time, active_process_bcp->program_counter_val - 1, 1);
         return;
     }
 
-    // Obtém a instrução atual com base no valor do Program Counter (PC).
-    Node *instruction_node = active_process_bcp->instructions_list_ptr->head;
-    for (int i = 0; i < active_process_bcp->program_counter_val; i++)
-    {
-        if (instruction_node)
-            instruction_node = instruction_node->next;
-    }
+    // Marcadores de 'repeat' não consomem tempo: são resolvidos aqui, antes da busca da
+    // próxima instrução real. O parser descarta blocos vazios ou com zero repetições,
+    // então cada volta executa ao menos uma instrução real.
+    advance_over_loop_markers(active_process_bcp);
 
-    // Segurança: Se, por algum motivo, o nó da instrução for nulo, encerra o processo.
-    if (!instruction_node)
+    // Verifica se o processo terminou (se o contador de programa ultrapassou o número de instruções).
+    if (active_process_bcp->program_counter_val >= active_process_bcp->instruction_count)
     {
+        // Se terminou, despacha um evento de finalização para o kernel.
+        // O estado muda já aqui, para que nenhuma troca de contexto o devolva à fila de prontos.
+        Process__set_state(active_process_bcp, PROCESS_STATE_TERMINATED);
+        CPU__set_busy(active_process_bcp, 1); // A CPU aguarda o kernel tratar a finalização.
         Kernel__dispatch_event(EVT_PROCESS_FINISH, active_process_bcp);
         return;
     }
 
-    Instruction *current_instruction = (Instruction *)instruction_node->data;
+    // Obtém a instrução atual com base no valor do Program Counter (PC).
+    const Instruction *current_instruction = &active_process_bcp->instructions[active_process_bcp->program_counter_val];
     // Avança o Program Counter para a próxima instrução, preparando para a próxima execução.
     active_process_bcp->program_counter_val++;
 
@@ -68,8 +116,24 @@ void execute_current_process_instruction(Bcp *active_process_bcp)
     {
         // Instrução de uso de CPU: simula um trabalho computacional.
         long long exec_time = current_instruction->value_operand;
-        CPU__set_busy(1);                                                           // Trava a CPU, indicando que está ocupada.
-        Clock__schedule_event(exec_time, EVT_CPU_TIMER_FINISH, active_process_bcp); // Agenda um evento para destravar a CPU após o tempo de execução.
+        int burst_start_pc = active_process_bcp->program_counter_val - 1;
+        int burst_length = 1;
+        // 'exec's seguintes viram uma única rajada, com um só evento de fim: o resultado
+        // simulado é o mesmo (ver Process__interrupt_cpu_burst), com menos eventos.
+        if (kernel_config.fuse_exec && exec_time > 0)
+        {
+            const Instruction *next_instruction = current_instruction + 1;
+            const Instruction *program_end = active_process_bcp->instructions + active_process_bcp->instruction_count;
+            while (next_instruction < program_end && next_instruction->op_code_val == OP_CODE_EXEC &&
+                   next_instruction->value_operand > 0)
+            {
+                exec_time += next_instruction->value_operand;
+                next_instruction++;
+                burst_length++;
+            }
+            active_process_bcp->program_counter_val += burst_length - 1;
+        }
+        start_cpu_burst(active_process_bcp, exec_time, burst_start_pc, burst_length);
         break;
     }
     case OP_CODE_READ:
@@ -80,51 +144,59 @@ void execute_current_process_instruction(Bcp *active_process_bcp)
         Scheduler__update_process_io_stats(active_process_bcp, (current_instruction->op_code_val == OP_CODE_READ));
 
         // Prepara os argumentos para o evento de requisição de disco.
-        IOArgs *args = malloc(sizeof(IOArgs));
+        IOArgs *args = allocate_io_args();
         args->process = active_process_bcp;
         args->value = current_instruction->value_operand; // O valor é a trilha do disco.
+        Process__block(active_process_bcp, METRICS_WAIT_IO); // O processo bloqueia até o fim do I/O.
+        CPU__set_busy(active_process_bcp, 1);             // A CPU aguarda o kernel escalonar outro processo.
         Kernel__dispatch_event(EVT_DISK_REQUEST, args);   // Despacha o evento para o kernel.
         break;
     }
     case OP_CODE_PRINT:
     {
         // Instrução de I/O de Impressora.
-        IOArgs *args = malloc(sizeof(IOArgs));
+        IOArgs *args = allocate_io_args();
         args->process = active_process_bcp;
         args->value = current_instruction->value_operand; // O valor é o tempo de impressão.
+        Process__block(active_process_bcp, METRICS_WAIT_IO);
+        CPU__set_busy(active_process_bcp, 1);
         Kernel__dispatch_event(EVT_PRINT_REQUEST, args);
         break;
     }
     case OP_CODE_SEM_P:
     {
         // Operação P (wait) em um semáforo.
-        SemaArgs *args = malloc(sizeof(SemaArgs));
+        SemaArgs *args = allocate_sema_args();
         args->process = active_process_bcp;
         // Encontra o semáforo correspondente pelo seu caractere identificador.
         args->semaphore = find_semaphore_by_char_id(current_instruction->semaphore_id_char);
         if (args->semaphore) // Se o semáforo foi encontrado...
         {
+            active_process_bcp->pending_syscall = 1;       // O processo não pode ser preemptado até o kernel responder.
+            CPU__set_busy(active_process_bcp, 1);          // A CPU aguarda o resultado da operação.
             Kernel__dispatch_event(EVT_SEMAPHORE_P, args); // ...despacha o evento para o kernel.
         }
         else
         {
-            free(args); // Libera a memória se o semáforo não existir.
+            release_sema_args(args); // Devolve os argumentos se o semáforo não existir.
         }
         break;
     }
     case OP_CODE_SEM_V:
     {
         // Operação V (signal) em um semáforo.
-        SemaArgs *args = malloc(sizeof(SemaArgs));
+        SemaArgs *args = allocate_sema_args();
         args->process = active_process_bcp;
         args->semaphore = find_semaphore_by_char_id(current_instruction->semaphore_id_char);
         if (args->semaphore)
         {
+            active_process_bcp->pending_syscall = 1;
+            CPU__set_busy(active_process_bcp, 1);
             Kernel__dispatch_event(EVT_SEMAPHORE_V, args);
         }
         else
         {
-            free(args);
+            release_sema_args(args);
         }
         break;
     }
@@ -135,120 +207,180 @@ void execute_current_process_instruction(Bcp *active_process_bcp)
 }
 
 // -----------------------------------------------------------------------------
-// Função de criação de processo a partir de um arquivo sintético (.synt).
-// Lê o arquivo, inicializa o BCP e agenda o evento para carregar na memória.
+// Preempção no meio de uma rajada de 'exec's fundidos.
 // -----------------------------------------------------------------------------
-Bcp *Process__create(char *synthetic_file_path)
+void Process__interrupt_cpu_burst(Bcp *target_bcp, int keep_remaining)
 {
-    FILE *file_pointer = fopen(synthetic_file_path, "r");
-    if (!file_pointer) // Verifica se o arquivo pôde ser aberto.
-        return NULL;
-
-    Bcp *new_pcb = malloc(sizeof(Bcp));
-    if (!new_pcb) // Verifica se a alocação de memória para o BCP foi bem-sucedida.
+    int burst_length = target_bcp->cpu_burst_length;
+    target_bcp->cpu_burst_length = 0;
+    if (burst_length == 0)
+        return; // Nenhuma rajada em andamento
+    if (burst_length == 1)
     {
-        fclose(file_pointer);
-        return NULL;
+        // Um 'exec' isolado já é tratado como executado; só o fim do quantum guarda o restante.
+        long long remaining_time = target_bcp->cpu_burst_end_time - Clock__get_time();
+        if (keep_remaining && remaining_time > 0)
+            target_bcp->remaining_exec_time = remaining_time;
+        return;
     }
 
-    // Inicializa o BCP com zeros e define os valores iniciais.
-    memset(new_pcb, 0, sizeof(Bcp));
-    new_pcb->pid = kernel_instance->proc_id_counter++; // Atribui um PID único e incrementa o contador global.
-    new_pcb->current_execution_state = PROCESS_STATE_NEW;
-
-    // Lê os campos do cabeçalho do arquivo sintético.
-    char buffer[256];
-    fgets(buffer, sizeof(buffer), file_pointer);
-    buffer[strcspn(buffer, "\n\r")] = 0; // Remove quebras de linha.
-    new_pcb->name_str = strdup(buffer);  // Copia o nome do processo.
-    fgets(buffer, sizeof(buffer), file_pointer);
-    new_pcb->segment_identifier = atoi(buffer); // Converte string para inteiro.
-    fgets(buffer, sizeof(buffer), file_pointer);
-    new_pcb->priority_level = atoi(buffer);
-    fgets(buffer, sizeof(buffer), file_pointer);
-    new_pcb->segment_size_bytes = atoi(buffer) * KBYTE_DEF; // Converte o tamanho para bytes.
-    fgets(buffer, sizeof(buffer), file_pointer);
-    // Lê e inicializa os semáforos que este processo utilizará.
-    Semaph__read_and_init_semaphores_from_line(buffer);
-
-    // Lê todas as instruções do arquivo e as armazena na lista de instruções do BCP.
-    new_pcb->instructions_list_ptr = read_synthetic_file_instructions(file_pointer);
-    fclose(file_pointer);
+    const Instruction *burst = &target_bcp->instructions[target_bcp->cpu_burst_start_pc];
+    long long burst_time = 0;
+    for (int i = 0; i < burst_length; i++)
+        burst_time += burst[i].value_operand;
+    long long elapsed = Clock__get_time() - (target_bcp->cpu_burst_end_time - burst_time);
 
-    // Despacha um evento para que o kernel requisite o carregamento do processo na memória.
-    Kernel__dispatch_event(EVT_MEM_LOAD_REQ, (void *)new_pcb);
-    return new_pcb; // Retorna o BCP recém-criado.
+    // Sem fusão, o 'exec' i só começa depois que o evento de fim do anterior é tratado.
+    // Esse evento é o último de seu instante, então um 'exec' que começaria exatamente
+    // agora ainda não começou. O primeiro 'exec' sempre conta como executado.
+    int started_count = 1;
+    long long start_offset = burst[0].value_operand;
+    while (started_count < burst_length && start_offset < elapsed)
+    {
+        start_offset += burst[started_count].value_operand;
+        started_count++;
+    }
+    target_bcp->program_counter_val = target_bcp->cpu_burst_start_pc + started_count;
+    if (keep_remaining && start_offset > elapsed)
+        target_bcp->remaining_exec_time = start_offset - elapsed; // Fim do 'exec' em andamento
 }
 
 // -----------------------------------------------------------------------------
-// Função auxiliar que lê todas as linhas de instrução do arquivo e as monta
-// em uma lista de estruturas 'Instruction'.
+// Inicializa um BCP novo para executar 'program', com PID próprio e contadores
+// zerados. O BCP recebe uma referência ao programa, já obtida por quem chama.
+// Deve ser chamada com process_table_mutex (o PID e a entrada na tabela são
+// atribuídos juntos). Retorna 0 se a tabela de processos estiver cheia.
 // -----------------------------------------------------------------------------
-List *read_synthetic_file_instructions(FILE *fp)
+static int setup_process_locked(Bcp *new_pcb, Program *program)
 {
-    List *instructions = create_list();
-    char line_buffer[256];
-    // Lê o arquivo linha por linha até o final.
-    while (fgets(line_buffer, sizeof(line_buffer), fp))
+    // Inicializa o BCP com zeros e define os valores iniciais.
+    memset(new_pcb, 0, sizeof(Bcp));
+    new_pcb->pid = kernel_instance->proc_id_counter++; // Atribui um PID único e incrementa o contador global.
+
+    // Copia os campos do cabeçalho e aponta para as instruções compartilhadas.
+    new_pcb->program = program;
+    new_pcb->name_str = program->name_str;
+    new_pcb->segment_identifier = program->segment_identifier;
+    new_pcb->segment_size_bytes = program->segment_size_bytes;
+    new_pcb->instructions = program->instructions;
+    new_pcb->instruction_count = program->instruction_count;
+    new_pcb->metadata = &program->metadata;
+    Metrics__process_created(&new_pcb->metrics); // Chega ao sistema agora, no estado NOVO
+
+    // Entra na tabela de processos (que guarda seu estado) antes de ficar visível aos handlers.
+    ProcessHandle handle = ProcessTable__insert(&kernel_instance->process_table, new_pcb);
+    if (handle.generation == 0)
     {
-        // Converte cada linha em uma estrutura de instrução.
-        Instruction *instr = parse_instruction_from_string(line_buffer);
-        if (instr) // Se a instrução for válida...
-            add_to_list(instructions, instr); // ...a adiciona à lista.
+        kernel_instance->proc_id_counter--; // O PID não chegou a ser usado
+        return 0;
     }
-    return instructions;
+    return 1;
 }
 
 // -----------------------------------------------------------------------------
-// Função auxiliar que converte uma única linha de texto em uma estrutura 'Instruction'.
+// Criação de processo a partir de um arquivo sintético (.synt), em duas etapas:
+// o BCP é montado e inserido na tabela, e só depois iniciado (carga na memória).
 // -----------------------------------------------------------------------------
-Instruction *parse_instruction_from_string(char *instruction_line)
+Bcp *Process__create_unstarted(char *synthetic_file_path, char *error_message, size_t error_size)
 {
-    // Ignora linhas vazias ou inválidas.
-    if (!instruction_line || instruction_line[0] == '\n' || instruction_line[0] == '\r')
+    // O programa vem do cache: réplicas do mesmo arquivo compartilham uma única cópia.
+    Program *program = Program__acquire(synthetic_file_path, error_message, error_size);
+    if (!program) // Verifica se o arquivo pôde ser lido.
         return NULL;
 
-    Instruction *instr = malloc(sizeof(Instruction));
-    if (!instr)
+    Bcp *new_pcb = malloc(sizeof(Bcp));
+    if (!new_pcb) // Verifica se a alocação de memória para o BCP foi bem-sucedida.
+    {
+        Program__release(program);
+        if (error_message != NULL && error_size > 0)
+            snprintf(error_message, error_size, "%s: memoria insuficiente", synthetic_file_path);
         return NULL;
-    memset(instr, 0, sizeof(Instruction));
+    }
 
-    char opcode_str[32];
-    int value = 0;
-    // Extrai a palavra-chave da operação e o valor numérico da linha.
-    sscanf(instruction_line, "%s %d", opcode_str, &value);
+    pthread_mutex_lock(&process_table_mutex);
+    int inserted = setup_process_locked(new_pcb, program);
+    pthread_mutex_unlock(&process_table_mutex);
+    if (!inserted)
+    {
+        Program__release(program);
+        free(new_pcb);
+        if (error_message != NULL && error_size > 0)
+            snprintf(error_message, error_size, "%s: tabela de processos cheia", synthetic_file_path);
+        return NULL;
+    }
+
+    // Inicializa os semáforos que este processo utilizará.
+    Semaph__read_and_init_semaphores_from_line(program->semaphore_ids);
+    return new_pcb;
+}
 
-    instr->value_operand = value;
-    // Converte a string do opcode (ex: "exec") para o valor enum correspondente.
-    translate_string_to_opcode(instr, opcode_str);
+void Process__start(Bcp *new_process)
+{
+    // Despacha um evento para que o kernel requisite o carregamento do processo na memória.
+    Kernel__dispatch_event(EVT_MEM_LOAD_REQ, (void *)new_process);
+}
 
-    return instr;
+Bcp *Process__create(char *synthetic_file_path, char *error_message, size_t error_size)
+{
+    Bcp *new_pcb = Process__create_unstarted(synthetic_file_path, error_message, error_size);
+    if (new_pcb)
+        Process__start(new_pcb);
+    return new_pcb; // Retorna o BCP recém-criado.
 }
 
 // -----------------------------------------------------------------------------
-// Função auxiliar que traduz a string do opcode para o valor enum correspondente.
+// Cópias de um processo modelo. O programa (instruções e metadados) é somente
+// leitura e fica compartilhado: cada cópia custa um BCP, uma entrada na tabela e
+// um evento de carga, sem abrir nem interpretar o arquivo. A tabela é travada uma
+// única vez e as cargas são despachadas em um único lote.
 // -----------------------------------------------------------------------------
-void translate_string_to_opcode(Instruction *target_instruction, char *opcode_keyword)
+int Process__spawn(const Bcp *template_bcp, int count)
 {
-    if (!strcmp("exec", opcode_keyword))
-        target_instruction->op_code_val = OP_CODE_EXEC;
-    else if (!strcmp("read", opcode_keyword))
-        target_instruction->op_code_val = OP_CODE_READ;
-    else if (!strcmp("write", opcode_keyword))
-        target_instruction->op_code_val = OP_CODE_WRITE;
-    else if (!strcmp("print", opcode_keyword))
-        target_instruction->op_code_val = OP_CODE_PRINT;
-    // Tratamento especial para semáforos, para extrair o caractere identificador.
-    else if (!strncmp("P(", opcode_keyword, 2))
-    {
-        target_instruction->op_code_val = OP_CODE_SEM_P;
-        target_instruction->semaphore_id_char = opcode_keyword[2]; // Pega o 3º caractere, ex: 'S' de "P(S)".
-    }
-    else if (!strncmp("V(", opcode_keyword, 2))
+    if (!template_bcp || count <= 0)
+        return 0;
+    EventDispatch *load_events = malloc(sizeof(EventDispatch) * count);
+    if (!load_events)
+        return 0;
+
+    Program *program = template_bcp->program;
+    int created = 0;
+    pthread_mutex_lock(&process_table_mutex);
+    while (created < count)
     {
-        target_instruction->op_code_val = OP_CODE_SEM_V;
-        target_instruction->semaphore_id_char = opcode_keyword[2]; // Pega o 3º caractere, ex: 'S' de "V(S)".
+        Bcp *clone = malloc(sizeof(Bcp));
+        if (!clone)
+            break;
+        if (!setup_process_locked(clone, program))
+        {
+            free(clone);
+            break;
+        }
+        load_events[created].type = EVT_MEM_LOAD_REQ;
+        load_events[created].data = clone;
+        created++;
     }
+    pthread_mutex_unlock(&process_table_mutex);
+
+    // Uma referência ao programa por cópia; os semáforos já foram criados pelo modelo.
+    Program__retain(program, created);
+    Kernel__dispatch_events_batch(load_events, created);
+    free(load_events);
+    return created;
+}
+
+// -----------------------------------------------------------------------------
+// Libera todos os recursos de um processo já finalizado pelo kernel.
+// -----------------------------------------------------------------------------
+void Process__finish(Bcp *target_bcp)
+{
+    if (!target_bcp)
+        return;
+    // O slot (e as colunas com o estado) só é liberado junto com o BCP.
+    pthread_mutex_lock(&process_table_mutex);
+    ProcessTable__remove(&kernel_instance->process_table, target_bcp->table_handle);
+    pthread_mutex_unlock(&process_table_mutex);
+    Program__release(target_bcp->program); // O programa continua no cache para novas réplicas.
+    free(target_bcp);                      // Libera o BCP
 }
 
 // -----------------------------------------------------------------------------
@@ -2,6 +2,10 @@
 #define PROCESS_H_GUARD
 
 #include "../Ferramentas/list.h"
+#include "program.h"
+#include "../Nucleo/process_table.h"
+#include "../escalonador/sched_class.h"
+#include "../Nucleo/metrics.h"
 #include <stdio.h>
 
 // Forward declaration para evitar dependências circulares com semaf.h
@@ -11,25 +15,6 @@ struct Semaphore_t;
 // Tipos e enums relacionados a processos e instruções
 // -----------------------------------------------------------------------------
 
-// Enumeração dos códigos de operação suportados por instruções de processo
-typedef enum
-{
-    OP_CODE_EXEC = 0,  // exec <tempo>
-    OP_CODE_READ = 1,  // read <trilha>
-    OP_CODE_WRITE = 2, // write <trilha>
-    OP_CODE_PRINT = 3, // print <tempo>
-    OP_CODE_SEM_P = 4, // P(<id>)
-    OP_CODE_SEM_V = 5  // V(<id>)
-} OperationCodeValue;
-
-// Estrutura de uma instrução de processo
-typedef struct Instruction_s
-{
-    OperationCodeValue op_code_val; // Código da operação
-    int value_operand;              // Operando numérico (tempo, trilha, etc.)
-    char semaphore_id_char;         // Identificador do semáforo (se aplicável)
-} Instruction;
-
 // Enumeração dos estados possíveis de um processo
 typedef enum
 {
@@ -44,17 +29,68 @@ typedef enum
 typedef struct Bcp_t
 {
     int pid;                                     // Identificador do processo
-    char *name_str;                              // Nome do processo
-    ProcessCurrentState current_execution_state; // Estado atual
+    ProcessHandle table_handle;                  // Posição na tabela de processos do kernel
+    const char *name_str;                        // Nome do processo (pertence ao programa)
+    ProcessHotChunk *hot;                        // Colunas da tabela de processos com estado, E/S e prioridade
+    int hot_index;                               // Posição do processo nessas colunas
     int program_counter_val;                     // Program Counter (índice da próxima instrução)
     int segment_identifier;                      // Identificador do segmento de memória
-    int priority_level;                          // Prioridade do processo
     int segment_size_bytes;                      // Tamanho do segmento em bytes
-    int total_read_ops;                          // Total de operações de leitura realizadas
+    int total_read_ops;                          // Total de operações de leitura realizadas (a soma fica nas colunas quentes)
     int total_write_ops;                         // Total de operações de escrita realizadas
-    List *instructions_list_ptr;                 // Lista de instruções do processo
+    Program *program;                            // Programa executado (compartilhado, uma referência por BCP)
+    const Instruction *instructions;             // Instruções do programa (somente leitura)
+    int instruction_count;                       // Quantidade de instruções no vetor
+    const ProgramMetadata *metadata;             // Metadados do programa (tempo de CPU, E/S, páginas, semáforos)
+    int loop_remaining[PROGRAM_MAX_LOOP_DEPTH];  // Repetições restantes de cada bloco 'repeat' aberto
+    int loop_depth;                              // Blocos 'repeat' abertos
+    long long cpu_burst_end_time;                // Instante virtual em que o 'exec' atual termina
+    int cpu_burst_start_pc;                      // Índice do primeiro 'exec' da rajada atual
+    int cpu_burst_length;                        // 'exec's fundidos na rajada atual (0 = nenhuma em andamento)
+    long long remaining_exec_time;               // Restante do 'exec' interrompido pelo fim do quantum (0 = nenhum)
+    long long slice_end_time;                    // Instante virtual em que o quantum atual termina (com --quantum)
+    int quantum_expired;                         // 1 se o quantum acabou e a troca de contexto está pendente (trava da CPU)
+    int pending_cpu_timers;                      // Eventos de fim de 'exec' ainda não tratados (protegido pela trava da CPU)
+    int pending_syscall;                         // 1 enquanto uma operação P/V aguarda o kernel (protegido pela trava da CPU)
+    int is_finalized;                            // 1 após o kernel tratar a finalização do processo
+    int cpu_core;                                // Núcleo em que executa, ou em cuja fila de prontos está (muda sob ready_queue_mutex)
+    SchedEntity sched;                           // Dados da classe de escalonamento (protegido por ready_queue_mutex)
+    ProcessMetrics metrics;                      // Tempo passado em cada estado (ver metrics.h)
 } Bcp;
 
+// -----------------------------------------------------------------------------
+// Campos quentes do processo, guardados nas colunas da tabela de processos.
+// -----------------------------------------------------------------------------
+static inline ProcessCurrentState Process__get_state(const Bcp *process)
+{
+    return (ProcessCurrentState)process->hot->state[process->hot_index];
+}
+
+// Toda mudança de estado passa por aqui, para que as métricas do processo contabilizem
+// o tempo passado no estado anterior.
+static inline void Process__set_state(Bcp *process, ProcessCurrentState new_state)
+{
+    Metrics__record_transition(&process->metrics, Process__get_state(process), new_state);
+    process->hot->state[process->hot_index] = (unsigned char)new_state;
+}
+
+// Bloqueia o processo (estado ESPERANDO), registrando o motivo para as métricas.
+static inline void Process__block(Bcp *process, MetricsWaitReason reason)
+{
+    process->metrics.wait_reason = reason;
+    Process__set_state(process, PROCESS_STATE_WAITING);
+}
+
+static inline int Process__get_io_count(const Bcp *process)
+{
+    return process->hot->io_ops[process->hot_index];
+}
+
+static inline int Process__get_priority(const Bcp *process)
+{
+    return process->hot->priority[process->hot_index];
+}
+
 // -----------------------------------------------------------------------------
 // Funções do módulo de processo
 // -----------------------------------------------------------------------------
@@ -62,12 +98,35 @@ typedef struct Bcp_t
 /**
  * @brief Cria um novo processo a partir de um arquivo sintético.
  * @param synthetic_file_path Caminho para o arquivo de definição do processo.
- * @return Ponteiro para o BCP criado.
+ * @param error_message Recebe a descrição do erro se o arquivo for inválido (pode ser NULL).
+ * @param error_size Tamanho do buffer de erro.
+ * @return Ponteiro para o BCP criado, ou NULL em caso de erro.
+ */
+Bcp *Process__create(char *synthetic_file_path, char *error_message, size_t error_size);
+
+/**
+ * @brief Como Process__create, mas sem iniciar o processo: o BCP já está na tabela de
+ * processos, e a carga na memória só começa com Process__start. Permite usá-lo como
+ * modelo de Process__spawn sem que ele termine (e seja liberado) durante a cópia.
+ */
+Bcp *Process__create_unstarted(char *synthetic_file_path, char *error_message, size_t error_size);
+
+/**
+ * @brief Inicia um processo criado com Process__create_unstarted.
+ */
+void Process__start(Bcp *new_process);
+
+/**
+ * @brief Cria 'count' cópias de um processo, que compartilham seu programa (somente
+ * leitura) e recebem PIDs e contadores próprios. As cópias já são iniciadas.
+ * @param template_bcp Processo modelo; deve continuar vivo durante a chamada.
+ * @param count Quantidade de cópias.
+ * @return Cópias criadas (menos que 'count' se faltar memória ou a tabela encher).
  */
-Bcp *Process__create(char *synthetic_file_path);
+int Process__spawn(const Bcp *template_bcp, int count);
 
 /**
- * @brief Finaliza um processo e libera seus recursos.
+ * @brief Remove um processo da tabela de processos e libera seus recursos.
  * @param target_bcp Ponteiro para o BCP do processo a ser finalizado.
  */
 void Process__finish(Bcp *target_bcp);
@@ -79,14 +138,15 @@ void Process__finish(Bcp *target_bcp);
 void execute_current_process_instruction(Bcp *active_process_bcp);
 
 /**
- * @brief Traduz uma string de opcode para o valor numérico correspondente.
- */
-void translate_string_to_opcode(Instruction *instruction_ptr, char *opcode_string);
-
-/**
- * @brief Faz o parsing de uma linha de instrução para a estrutura Instruction.
+ * @brief Ajusta o Program Counter de um processo preemptado no meio de uma rajada de
+ * 'exec's fundidos, como se cada 'exec' tivesse sido executado separadamente: os que
+ * já começaram até o instante atual contam como executados, os demais voltam a ser
+ * pendentes. Deve ser chamada com a trava da CPU.
+ * @param keep_remaining 1 se o processo saiu pelo fim do quantum: o que falta do 'exec'
+ * em andamento é guardado em remaining_exec_time e executado quando ele voltar à CPU.
+ * Nas demais preempções, o 'exec' em andamento conta como concluído.
  */
-Instruction *parse_instruction_from_string(char *instruction_line);
+void Process__interrupt_cpu_burst(Bcp *target_bcp, int keep_remaining);
 
 /**
  * @brief Inicializa semáforos a partir de uma linha do arquivo sintético.
@@ -0,0 +1,792 @@
+#include "program.h"
+#include "../Memoria/Page.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Define um Kbyte como 1024, para conversões de tamanho de segmento.
+#ifndef KBYTE_DEF
+#define KBYTE_DEF 1024
+#endif
+
+#define PROGRAM_CACHE_BUCKETS 1024 // Entradas da tabela hash (potência de dois)
+
+// Cache de programas: tabela hash encadeada indexada pelo caminho do arquivo.
+// O cache mantém uma referência a cada programa que contém.
+static pthread_mutex_t program_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t program_cache_cond = PTHREAD_COND_INITIALIZER; // Sinalizada ao fim de cada leitura
+static Program *program_cache[PROGRAM_CACHE_BUCKETS];
+static long long cache_requests = 0; // Pedidos ao cache (protegidos pelo mutex)
+static long long cache_loads = 0;    // Arquivos efetivamente lidos (protegidos pelo mutex)
+static long long cache_failures = 0; // Pedidos de arquivos ausentes ou inválidos (protegidos pelo mutex)
+
+// Hash FNV-1a do caminho
+static unsigned int hash_path(const char *path)
+{
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *cursor = (const unsigned char *)path; *cursor != '\0'; cursor++)
+    {
+        hash ^= *cursor;
+        hash *= 16777619u;
+    }
+    return hash & (PROGRAM_CACHE_BUCKETS - 1);
+}
+
+// -----------------------------------------------------------------------------
+// Leitor do formato .synt.
+//
+// O arquivo é mapeado em memória e percorrido uma única vez, sem cópias nem
+// sscanf: as linhas são delimitadas com memchr e cada token é reconhecido no
+// próprio mapeamento. Não há limite de tamanho de linha.
+// -----------------------------------------------------------------------------
+
+// Estado do leitor
+typedef struct
+{
+    const char *path;    // Arquivo lido (para as mensagens de erro)
+    const char *cursor;  // Início da próxima linha
+    const char *end;     // Fim do arquivo
+    int line_number;     // Número da linha atual (a partir de 1)
+    char *error;         // Recebe a mensagem de erro
+    size_t error_size;
+} SyntScanner;
+
+// Registra um erro na linha atual. Sempre retorna 0, para ser usada em 'return'.
+static int scanner_error(SyntScanner *scanner, const char *message, const char *token, const char *token_end)
+{
+    if (scanner->error != NULL && scanner->error_size > 0)
+    {
+        // Erros anteriores à primeira linha (ex: ao abrir o arquivo) não têm número de linha.
+        char location[32] = "";
+        if (scanner->line_number > 0)
+            snprintf(location, sizeof(location), ":%d", scanner->line_number);
+        if (token != NULL)
+            snprintf(scanner->error, scanner->error_size, "%s%s: %s '%.*s'", scanner->path, location, message,
+                     (int)(token_end - token), token);
+        else
+            snprintf(scanner->error, scanner->error_size, "%s%s: %s", scanner->path, location, message);
+    }
+    return 0;
+}
+
+// Avança para a próxima linha. Retorna 0 no fim do arquivo; senão, delimita a
+// linha em [*line, *line_end), sem a quebra de linha (\n ou \r\n).
+static int scanner_next_line(SyntScanner *scanner, const char **line, const char **line_end)
+{
+    if (scanner->cursor >= scanner->end)
+        return 0;
+    const char *start = scanner->cursor;
+    const char *newline = memchr(start, '\n', (size_t)(scanner->end - start));
+    const char *stop = newline ? newline : scanner->end;
+    scanner->cursor = newline ? newline + 1 : scanner->end;
+    scanner->line_number++;
+    if (stop > start && stop[-1] == '\r')
+        stop--;
+    *line = start;
+    *line_end = stop;
+    return 1;
+}
+
+static int is_blank(char character)
+{
+    return character == ' ' || character == '\t' || character == '\r' || character == '\v' || character == '\f';
+}
+
+static const char *skip_blanks(const char *cursor, const char *end)
+{
+    while (cursor < end && is_blank(*cursor))
+        cursor++;
+    return cursor;
+}
+
+// Lê um inteiro (com sinal opcional) em [*cursor, end). Retorna 0 se não houver dígitos ou se houver estouro.
+static int scan_int(const char **cursor, const char *end, int *value)
+{
+    const char *position = *cursor;
+    int negative = 0;
+    if (position < end && (*position == '-' || *position == '+'))
+        negative = (*position++ == '-');
+    if (position >= end || *position < '0' || *position > '9')
+        return 0;
+
+    long long result = 0;
+    while (position < end && *position >= '0' && *position <= '9')
+    {
+        result = result * 10 + (*position++ - '0');
+        if (result > 2147483647LL)
+            return 0;
+    }
+    *value = negative ? (int)-result : (int)result;
+    *cursor = position;
+    return 1;
+}
+
+// Lê uma linha do cabeçalho que contém apenas um inteiro.
+static int scan_header_int(SyntScanner *scanner, const char *field_name, int *value)
+{
+    const char *line, *line_end;
+    if (!scanner_next_line(scanner, &line, &line_end))
+    {
+        scanner->line_number++;
+        return scanner_error(scanner, "fim de arquivo no cabecalho, esperado", field_name, field_name + strlen(field_name));
+    }
+    const char *cursor = skip_blanks(line, line_end);
+    if (!scan_int(&cursor, line_end, value) || skip_blanks(cursor, line_end) != line_end)
+        return scanner_error(scanner, "valor invalido no cabecalho", line, line_end);
+    return 1;
+}
+
+// Copia uma linha inteira para uma string alocada.
+static char *copy_line(const char *line, const char *line_end)
+{
+    size_t length = (size_t)(line_end - line);
+    char *copy = malloc(length + 1);
+    if (copy)
+    {
+        memcpy(copy, line, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+// Reconhece uma instrução em [line, line_end). Retorna 1 se gravou uma instrução,
+// 0 em caso de erro (ver scanner->error). Linhas em branco devem ser filtradas antes.
+static int scan_instruction(SyntScanner *scanner, const char *line, const char *line_end, Instruction *instruction)
+{
+    const char *keyword = skip_blanks(line, line_end);
+    const char *keyword_end = keyword;
+    while (keyword_end < line_end && !is_blank(*keyword_end))
+        keyword_end++;
+    size_t length = (size_t)(keyword_end - keyword);
+
+    instruction->value_operand = 0;
+    instruction->semaphore_id_char = 0;
+
+    // Fim de bloco: '}' sozinho na linha. O índice do início é preenchido por quem chama.
+    if (length == 1 && keyword[0] == '}')
+    {
+        instruction->op_code_val = OP_CODE_END_REPEAT;
+        return 1;
+    }
+
+    // Início de bloco: 'repeat <n> {'
+    if (length == 6 && memcmp(keyword, "repeat", 6) == 0)
+    {
+        instruction->op_code_val = OP_CODE_REPEAT;
+        const char *count = skip_blanks(keyword_end, line_end);
+        if (!scan_int(&count, line_end, &instruction->value_operand) || instruction->value_operand < 0)
+            return scanner_error(scanner, "numero de repeticoes invalido em", keyword, line_end);
+        const char *brace = skip_blanks(count, line_end);
+        if (brace == line_end || *brace != '{' || skip_blanks(brace + 1, line_end) != line_end)
+            return scanner_error(scanner, "esperado '{' ao final de", keyword, line_end);
+        return 1;
+    }
+
+    // Operações de semáforo: P(x) e V(x), sem operando numérico.
+    if (length == 4 && (keyword[0] == 'P' || keyword[0] == 'V') && keyword[1] == '(' && keyword[3] == ')')
+    {
+        instruction->op_code_val = (keyword[0] == 'P') ? OP_CODE_SEM_P : OP_CODE_SEM_V;
+        instruction->semaphore_id_char = keyword[2];
+        if (skip_blanks(keyword_end, line_end) != line_end)
+            return scanner_error(scanner, "conteudo inesperado apos", keyword, keyword_end);
+        return 1;
+    }
+
+    if (length == 4 && memcmp(keyword, "exec", 4) == 0)
+        instruction->op_code_val = OP_CODE_EXEC;
+    else if (length == 4 && memcmp(keyword, "read", 4) == 0)
+        instruction->op_code_val = OP_CODE_READ;
+    else if (length == 5 && memcmp(keyword, "write", 5) == 0)
+        instruction->op_code_val = OP_CODE_WRITE;
+    else if (length == 5 && memcmp(keyword, "print", 5) == 0)
+        instruction->op_code_val = OP_CODE_PRINT;
+    else
+        return scanner_error(scanner, "instrucao desconhecida", keyword, keyword_end);
+
+    const char *operand = skip_blanks(keyword_end, line_end);
+    if (!scan_int(&operand, line_end, &instruction->value_operand))
+        return scanner_error(scanner, "operando numerico invalido ou ausente em", keyword, line_end);
+    // Tempos e trilhas negativos agendariam eventos no passado.
+    if (instruction->value_operand < 0)
+        return scanner_error(scanner, "operando negativo em", keyword, line_end);
+    if (skip_blanks(operand, line_end) != line_end)
+        return scanner_error(scanner, "conteudo inesperado apos o operando em", keyword, line_end);
+    return 1;
+}
+
+// Blocos 'repeat' abertos durante a leitura: valida o aninhamento e guarda por
+// quantas vezes as instruções de cada nível executam.
+typedef struct
+{
+    int depth;                                           // Blocos abertos
+    int begin_index[PROGRAM_MAX_LOOP_DEPTH];             // Índice do 'repeat' de cada nível
+    int begin_line[PROGRAM_MAX_LOOP_DEPTH];              // Linha do 'repeat' (para mensagens de erro)
+    long long multiplier[PROGRAM_MAX_LOOP_DEPTH + 1];    // Execuções de uma instrução em cada nível
+} LoopNesting;
+
+#define LOOP_MULTIPLIER_LIMIT INT_MAX // Satura o produto das repetições (evita estouro)
+
+static void loop_nesting_init(LoopNesting *nesting)
+{
+    nesting->depth = 0;
+    nesting->multiplier[0] = 1;
+}
+
+// Abre um bloco. Retorna 0 se a profundidade máxima for excedida.
+static int loop_nesting_open(LoopNesting *nesting, int begin_index, int line_number, int repetitions)
+{
+    if (nesting->depth == PROGRAM_MAX_LOOP_DEPTH)
+        return 0;
+    long long multiplier = nesting->multiplier[nesting->depth] * repetitions; // Ambos <= INT_MAX
+    nesting->begin_index[nesting->depth] = begin_index;
+    nesting->begin_line[nesting->depth] = line_number;
+    nesting->multiplier[nesting->depth + 1] = multiplier > LOOP_MULTIPLIER_LIMIT ? LOOP_MULTIPLIER_LIMIT : multiplier;
+    nesting->depth++;
+    return 1;
+}
+
+// Soma 'amount' a um contador, saturando em INT_MAX.
+static void add_saturated(int *counter, long long amount)
+{
+    long long total = *counter + amount;
+    *counter = total > INT_MAX ? INT_MAX : (int)total;
+}
+
+// Acumula os metadados de uma instrução executada 'multiplier' vezes.
+static void account_instruction(ProgramMetadata *metadata, const Instruction *instruction, long long multiplier)
+{
+    switch (instruction->op_code_val)
+    {
+    case OP_CODE_EXEC:
+    {
+        // Operando e multiplicador cabem em 31 bits: o produto não estoura, só a soma.
+        long long exec_time = instruction->value_operand * multiplier;
+        metadata->total_exec_time = (metadata->total_exec_time > LLONG_MAX - exec_time) ? LLONG_MAX
+                                                                                        : metadata->total_exec_time + exec_time;
+        break;
+    }
+    case OP_CODE_READ:
+        add_saturated(&metadata->read_count, multiplier);
+        break;
+    case OP_CODE_WRITE:
+        add_saturated(&metadata->write_count, multiplier);
+        break;
+    case OP_CODE_PRINT:
+        add_saturated(&metadata->print_count, multiplier);
+        break;
+    case OP_CODE_SEM_P:
+    case OP_CODE_SEM_V:
+    {
+        add_saturated(&metadata->semaphore_op_count, multiplier);
+        size_t used_count = strlen(metadata->semaphores_used);
+        if (strchr(metadata->semaphores_used, instruction->semaphore_id_char) == NULL &&
+            used_count < PROGRAM_MAX_SEMAPHORES_USED)
+        {
+            metadata->semaphores_used[used_count] = instruction->semaphore_id_char;
+            metadata->semaphores_used[used_count + 1] = '\0';
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// Completa os metadados derivados dos totais.
+static void finish_metadata(ProgramMetadata *metadata)
+{
+    // Cada unidade de tempo de 'exec' ocupa um byte do espaço de endereçamento virtual.
+    long long pages = (metadata->total_exec_time + PAGE_SIZE_IN_BYTES - 1) / PAGE_SIZE_IN_BYTES;
+    metadata->pages_required = pages > INT_MAX ? INT_MAX : (int)pages;
+}
+
+// Lê o cabeçalho e as instruções do arquivo mapeado para 'program'. Retorna 1 em caso de sucesso.
+static int scan_program(SyntScanner *scanner, Program *program)
+{
+    const char *line, *line_end;
+
+    // Cabeçalho: nome, segmento, prioridade, tamanho do segmento (KB) e semáforos.
+    if (!scanner_next_line(scanner, &line, &line_end))
+        return scanner_error(scanner, "arquivo vazio", NULL, NULL);
+    program->name_str = copy_line(line, line_end);
+    int segment_size_kb = 0;
+    if (!scan_header_int(scanner, "segmento", &program->segment_identifier) ||
+        !scan_header_int(scanner, "prioridade", &program->priority_level) ||
+        !scan_header_int(scanner, "tamanho do segmento", &segment_size_kb))
+        return 0;
+    program->segment_size_bytes = segment_size_kb * KBYTE_DEF; // Converte o tamanho para bytes.
+    if (!scanner_next_line(scanner, &line, &line_end))
+        line = line_end = scanner->end; // Sem linha de semáforos nem instruções
+    program->semaphore_ids = copy_line(line, line_end);
+
+    // Instruções: o vetor começa dimensionado por uma estimativa (uma instrução a
+    // cada ~8 bytes restantes, limitada) e dobra quando enche.
+    size_t remaining = (size_t)(scanner->end - scanner->cursor);
+    int capacity = (int)(remaining / 8 < 16 ? 16 : (remaining / 8 > 65536 ? 65536 : remaining / 8));
+    int count = 0;
+    Instruction *instructions = malloc(sizeof(Instruction) * capacity);
+    if (!instructions)
+        return scanner_error(scanner, "memoria insuficiente", NULL, NULL);
+
+    LoopNesting nesting;
+    loop_nesting_init(&nesting);
+    while (scanner_next_line(scanner, &line, &line_end))
+    {
+        if (skip_blanks(line, line_end) == line_end)
+            continue; // Linha em branco
+        if (count == capacity)
+        {
+            capacity *= 2;
+            Instruction *grown = realloc(instructions, sizeof(Instruction) * capacity);
+            if (!grown)
+            {
+                free(instructions);
+                return scanner_error(scanner, "memoria insuficiente", NULL, NULL);
+            }
+            instructions = grown;
+        }
+        Instruction *instruction = &instructions[count];
+        if (!scan_instruction(scanner, line, line_end, instruction))
+        {
+            free(instructions);
+            return 0;
+        }
+        if (instruction->op_code_val == OP_CODE_REPEAT)
+        {
+            if (!loop_nesting_open(&nesting, count, scanner->line_number, instruction->value_operand))
+            {
+                free(instructions);
+                return scanner_error(scanner, "blocos 'repeat' aninhados demais", NULL, NULL);
+            }
+        }
+        else if (instruction->op_code_val == OP_CODE_END_REPEAT)
+        {
+            if (nesting.depth == 0)
+            {
+                free(instructions);
+                return scanner_error(scanner, "'}' sem 'repeat' correspondente", NULL, NULL);
+            }
+            int begin_index = nesting.begin_index[--nesting.depth];
+            if (instructions[begin_index].value_operand == 0 || begin_index == count - 1)
+            {
+                count = begin_index; // Bloco que nunca executa nada: descartado
+                continue;
+            }
+            instruction->value_operand = begin_index;
+        }
+        else if (nesting.multiplier[nesting.depth] > 0)
+        {
+            // Instruções dentro de um 'repeat 0' nunca executam (o bloco é descartado ao
+            // fechar): não entram nos metadados, nem seus semáforos.
+            account_instruction(&program->metadata, instruction, nesting.multiplier[nesting.depth]);
+        }
+        count++;
+    }
+    if (nesting.depth > 0)
+    {
+        free(instructions);
+        scanner->line_number = nesting.begin_line[nesting.depth - 1];
+        return scanner_error(scanner, "bloco 'repeat' sem '}'", NULL, NULL);
+    }
+
+    // Devolve a sobra do vetor: o programa não cresce depois de carregado.
+    if (count > 0 && count < capacity)
+    {
+        Instruction *shrunk = realloc(instructions, sizeof(Instruction) * count);
+        if (shrunk)
+            instructions = shrunk;
+    }
+    program->instructions = instructions;
+    program->instruction_count = count;
+    finish_metadata(&program->metadata);
+    return 1;
+}
+
+// -----------------------------------------------------------------------------
+// Formato binário .syntb.
+//
+// Cabeçalho fixo, seguido do nome, da linha de semáforos e do vetor de
+// instruções no mesmo layout de 'Instruction' (8 bytes cada), alinhado a 8
+// bytes. O vetor é usado direto do mapeamento do arquivo, sem cópia.
+// -----------------------------------------------------------------------------
+#define SYNTB_MAGIC "SYNB"
+#define SYNTB_VERSION 1
+#define SYNTB_BYTE_ORDER_MARK 0x01020304u // Detecta arquivos gerados em outra ordem de bytes
+
+typedef struct
+{
+    char magic[4];                    // "SYNB"
+    uint16_t version;                 // SYNTB_VERSION
+    uint16_t instruction_size;        // sizeof(Instruction)
+    uint32_t byte_order_mark;         // SYNTB_BYTE_ORDER_MARK
+    int32_t segment_identifier;       // Identificador do segmento de memória
+    int32_t priority_level;           // Prioridade
+    int32_t segment_size_bytes;       // Tamanho do segmento em bytes
+    uint32_t name_length;             // Bytes do nome (sem terminador)
+    uint32_t semaphore_ids_length;    // Bytes da linha de semáforos (sem terminador)
+    uint32_t instruction_count;       // Quantidade de instruções
+    uint32_t instructions_offset;     // Posição do vetor de instruções no arquivo
+} SyntbHeader;
+
+static char *copy_bytes(const char *bytes, size_t length)
+{
+    return copy_line(bytes, bytes + length);
+}
+
+// Interpreta um arquivo .syntb mapeado. Em caso de sucesso, o programa passa a
+// ser dono do mapeamento (as instruções apontam para dentro dele).
+static int load_binary_program(SyntScanner *scanner, Program *program, const char *mapped, size_t mapped_size)
+{
+    SyntbHeader header;
+    if (mapped_size < sizeof(SyntbHeader))
+        return scanner_error(scanner, "cabecalho .syntb truncado", NULL, NULL);
+    memcpy(&header, mapped, sizeof(header));
+
+    if (header.version != SYNTB_VERSION)
+        return scanner_error(scanner, "versao de .syntb nao suportada (recompile com syntc)", NULL, NULL);
+    if (header.byte_order_mark != SYNTB_BYTE_ORDER_MARK || header.instruction_size != sizeof(Instruction))
+        return scanner_error(scanner, ".syntb gerado para outra arquitetura (recompile com syntc)", NULL, NULL);
+
+    size_t strings_end = sizeof(SyntbHeader) + (size_t)header.name_length + header.semaphore_ids_length;
+    size_t instructions_end = (size_t)header.instructions_offset + (size_t)header.instruction_count * sizeof(Instruction);
+    if (strings_end > mapped_size || header.instructions_offset < strings_end ||
+        header.instructions_offset % sizeof(int) != 0 || instructions_end > mapped_size)
+        return scanner_error(scanner, "arquivo .syntb corrompido", NULL, NULL);
+
+    // Uma única passada valida os opcodes e os blocos 'repeat' e deriva os metadados.
+    // Os blocos são conferidos como no texto, pois a execução confia nos índices.
+    const Instruction *instructions = (const Instruction *)(mapped + header.instructions_offset);
+    LoopNesting nesting;
+    loop_nesting_init(&nesting);
+    for (uint32_t i = 0; i < header.instruction_count; i++)
+    {
+        const Instruction *instruction = &instructions[i];
+        int valid = instruction->op_code_val <= OP_CODE_END_REPEAT;
+        if (instruction->op_code_val == OP_CODE_REPEAT)
+            valid = instruction->value_operand > 0 &&
+                    loop_nesting_open(&nesting, (int)i, 0, instruction->value_operand);
+        else if (instruction->op_code_val == OP_CODE_END_REPEAT)
+            valid = nesting.depth > 0 && nesting.begin_index[--nesting.depth] == instruction->value_operand &&
+                    (uint32_t)instruction->value_operand + 1 < i;
+        else if (instruction->op_code_val <= OP_CODE_PRINT && instruction->value_operand < 0)
+            valid = 0; // Tempos e trilhas negativos, rejeitados também no texto
+        else if (valid)
+            account_instruction(&program->metadata, instruction, nesting.multiplier[nesting.depth]);
+        if (!valid)
+        {
+            char detail[64];
+            snprintf(detail, sizeof(detail), "instrucao %u invalida no .syntb", i);
+            return scanner_error(scanner, detail, NULL, NULL);
+        }
+    }
+    if (nesting.depth > 0)
+        return scanner_error(scanner, "bloco 'repeat' sem fim no .syntb", NULL, NULL);
+    finish_metadata(&program->metadata);
+
+    const char *strings = mapped + sizeof(SyntbHeader);
+    program->name_str = copy_bytes(strings, header.name_length);
+    program->semaphore_ids = copy_bytes(strings + header.name_length, header.semaphore_ids_length);
+    program->segment_identifier = header.segment_identifier;
+    program->priority_level = header.priority_level;
+    program->segment_size_bytes = header.segment_size_bytes;
+    program->instructions = (Instruction *)instructions;
+    program->instruction_count = (int)header.instruction_count;
+    program->mapping = (void *)mapped;
+    program->mapping_size = mapped_size;
+    return 1;
+}
+
+int Program__write_binary(const Program *program, const char *output_path, char *error_message, size_t error_size)
+{
+    SyntbHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SYNTB_MAGIC, 4);
+    header.version = SYNTB_VERSION;
+    header.instruction_size = sizeof(Instruction);
+    header.byte_order_mark = SYNTB_BYTE_ORDER_MARK;
+    header.segment_identifier = program->segment_identifier;
+    header.priority_level = program->priority_level;
+    header.segment_size_bytes = program->segment_size_bytes;
+    header.name_length = (uint32_t)strlen(program->name_str);
+    header.semaphore_ids_length = (uint32_t)strlen(program->semaphore_ids);
+    header.instruction_count = (uint32_t)program->instruction_count;
+    size_t strings_end = sizeof(SyntbHeader) + header.name_length + header.semaphore_ids_length;
+    header.instructions_offset = (uint32_t)((strings_end + 7) & ~(size_t)7);
+
+    // Grava em um arquivo temporário no mesmo diretório e o renomeia sobre o destino: um
+    // .syntb carregado continua mapeado (MAP_PRIVATE) por quem o usa, e truncá-lo no lugar
+    // faria esse processo receber SIGBUS ao ler as instruções.
+    char temporary_path[PATH_MAX];
+    if (snprintf(temporary_path, sizeof(temporary_path), "%s.XXXXXX", output_path) >= (int)sizeof(temporary_path))
+    {
+        snprintf(error_message, error_size, "%s: caminho muito longo", output_path);
+        return -1;
+    }
+    int file_descriptor = mkstemp(temporary_path);
+    FILE *output = file_descriptor >= 0 ? fdopen(file_descriptor, "wb") : NULL;
+    if (output == NULL)
+    {
+        if (file_descriptor >= 0)
+        {
+            close(file_descriptor);
+            unlink(temporary_path);
+        }
+        snprintf(error_message, error_size, "%s: nao foi possivel criar o arquivo", output_path);
+        return -1;
+    }
+    fchmod(file_descriptor, 0644); // mkstemp cria o arquivo acessível só ao dono
+    static const char padding[8] = {0};
+    int failed = fwrite(&header, sizeof(header), 1, output) != 1 ||
+                 fwrite(program->name_str, 1, header.name_length, output) != header.name_length ||
+                 fwrite(program->semaphore_ids, 1, header.semaphore_ids_length, output) != header.semaphore_ids_length ||
+                 fwrite(padding, 1, header.instructions_offset - strings_end, output) != header.instructions_offset - strings_end ||
+                 fwrite(program->instructions, sizeof(Instruction), program->instruction_count, output) !=
+                     (size_t)program->instruction_count;
+    if (fclose(output) != 0 || failed)
+    {
+        unlink(temporary_path);
+        snprintf(error_message, error_size, "%s: erro ao gravar o arquivo", output_path);
+        return -1;
+    }
+    if (rename(temporary_path, output_path) != 0)
+    {
+        unlink(temporary_path);
+        snprintf(error_message, error_size, "%s: nao foi possivel substituir o arquivo", output_path);
+        return -1;
+    }
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Leitura de arquivos de programa (texto ou binário).
+// -----------------------------------------------------------------------------
+static void destroy_program(Program *program);
+
+// Lê o arquivo de programa e monta um novo programa. Arquivos que começam com a
+// assinatura do .syntb são carregados como binários; os demais, como texto .synt.
+static Program *load_program(const char *path, char *error, size_t error_size)
+{
+    SyntScanner scanner = {path, NULL, NULL, 0, error, error_size};
+    int file_descriptor = open(path, O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        scanner_error(&scanner, errno == ENOENT ? "arquivo nao encontrado" : "nao foi possivel abrir o arquivo",
+                      NULL, NULL);
+        return NULL;
+    }
+
+    // O tamanho e a data vêm do arquivo já aberto: se o caminho for truncado ou substituído
+    // depois de um stat(), o mapeamento e a chave do cache continuam descrevendo o que é lido.
+    struct stat file_info;
+    if (fstat(file_descriptor, &file_info) != 0)
+    {
+        close(file_descriptor);
+        scanner_error(&scanner, "nao foi possivel abrir o arquivo", NULL, NULL);
+        return NULL;
+    }
+    if (file_info.st_size == 0)
+    {
+        close(file_descriptor);
+        scanner_error(&scanner, "arquivo vazio", NULL, NULL);
+        return NULL;
+    }
+    size_t mapped_size = (size_t)file_info.st_size;
+    const char *mapped = mmap(NULL, mapped_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor); // O mapeamento continua válido sem o descritor
+    if (mapped == MAP_FAILED)
+    {
+        scanner_error(&scanner, "nao foi possivel mapear o arquivo", NULL, NULL);
+        return NULL;
+    }
+
+    Program *program = calloc(1, sizeof(Program));
+    if (!program)
+    {
+        munmap((void *)mapped, mapped_size);
+        scanner_error(&scanner, "memoria insuficiente", NULL, NULL);
+        return NULL;
+    }
+    program->path = strdup(path);
+    program->mtime = file_info.st_mtim;
+    program->file_size = (long long)file_info.st_size;
+    program->reference_count = 1; // Referência do cache
+
+    int loaded;
+    if (mapped_size >= 4 && memcmp(mapped, SYNTB_MAGIC, 4) == 0)
+    {
+        loaded = load_binary_program(&scanner, program, mapped, mapped_size);
+        if (!loaded)
+            munmap((void *)mapped, mapped_size);
+    }
+    else
+    {
+        madvise((void *)mapped, mapped_size, MADV_SEQUENTIAL);
+        scanner.cursor = mapped;
+        scanner.end = mapped + mapped_size;
+        loaded = scan_program(&scanner, program);
+        munmap((void *)mapped, mapped_size); // O texto não é mais necessário
+    }
+
+    if (!loaded)
+    {
+        destroy_program(program);
+        return NULL;
+    }
+    return program;
+}
+
+static void destroy_program(Program *program)
+{
+    free(program->path);
+    free(program->name_str);
+    free(program->semaphore_ids);
+    if (program->mapping != NULL)
+        munmap(program->mapping, program->mapping_size); // Instruções de um .syntb
+    else
+        free(program->instructions);
+    free(program);
+}
+
+Program *Program__load_file(const char *file_path, char *error_message, size_t error_size)
+{
+    return load_program(file_path, error_message, error_size);
+}
+
+// -----------------------------------------------------------------------------
+// Cache de programas.
+// -----------------------------------------------------------------------------
+
+// Retira um programa (ou uma reserva) da lista do seu balde. Chamada com o cache travado.
+static void unlink_cached_program(unsigned int bucket, Program *program)
+{
+    Program **link = &program_cache[bucket];
+    while (*link != NULL && *link != program)
+    {
+        link = &(*link)->next_in_bucket;
+    }
+    if (*link != NULL)
+        *link = program->next_in_bucket;
+}
+Program *Program__acquire(const char *synthetic_file_path, char *error_message, size_t error_size)
+{
+    struct stat file_info;
+    if (stat(synthetic_file_path, &file_info) != 0)
+    {
+        if (error_message != NULL && error_size > 0)
+            snprintf(error_message, error_size, "%s: arquivo nao encontrado", synthetic_file_path);
+        return NULL;
+    }
+
+    unsigned int bucket = hash_path(synthetic_file_path);
+    pthread_mutex_lock(&program_cache_mutex);
+    cache_requests++;
+
+    // Réplicas do mesmo arquivo criadas ao mesmo tempo esperam pela leitura em andamento
+    // em vez de interpretá-lo de novo.
+    Program *program;
+    while (1)
+    {
+        program = program_cache[bucket];
+        while (program != NULL && strcmp(program->path, synthetic_file_path) != 0)
+        {
+            program = program->next_in_bucket;
+        }
+        if (program == NULL || !program->is_loading)
+            break;
+        pthread_cond_wait(&program_cache_cond, &program_cache_mutex);
+    }
+
+    if (program != NULL &&
+        (program->mtime.tv_sec != file_info.st_mtim.tv_sec || program->mtime.tv_nsec != file_info.st_mtim.tv_nsec ||
+         program->file_size != (long long)file_info.st_size))
+    {
+        // O arquivo mudou: a versão antiga sai do cache (quem ainda a executa mantém sua referência).
+        unlink_cached_program(bucket, program);
+        Program__release(program);
+        program = NULL;
+    }
+
+    if (program == NULL)
+    {
+        // Reserva a entrada do arquivo e o lê com o cache destravado, para que leituras de
+        // outros arquivos e acertos no cache não esperem por esta.
+        Program reservation = {0};
+        reservation.path = (char *)synthetic_file_path;
+        reservation.is_loading = 1;
+        reservation.next_in_bucket = program_cache[bucket];
+        program_cache[bucket] = &reservation;
+        pthread_mutex_unlock(&program_cache_mutex);
+
+        program = load_program(synthetic_file_path, error_message, error_size);
+
+        pthread_mutex_lock(&program_cache_mutex);
+        unlink_cached_program(bucket, &reservation);
+        pthread_cond_broadcast(&program_cache_cond);
+        if (program == NULL)
+        {
+            // Quem esperava por esta leitura tenta de novo por conta própria.
+            cache_failures++;
+            pthread_mutex_unlock(&program_cache_mutex);
+            return NULL;
+        }
+        cache_loads++;
+        program->next_in_bucket = program_cache[bucket];
+        program_cache[bucket] = program;
+    }
+
+    __atomic_add_fetch(&program->reference_count, 1, __ATOMIC_RELAXED); // Referência do chamador
+    pthread_mutex_unlock(&program_cache_mutex);
+    return program;
+}
+
+void Program__retain(Program *program, int count)
+{
+    __atomic_add_fetch(&program->reference_count, count, __ATOMIC_RELAXED);
+}
+
+void Program__release(Program *program)
+{
+    if (program == NULL)
+        return;
+    if (__atomic_sub_fetch(&program->reference_count, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        destroy_program(program);
+    }
+}
+
+void Program__clear_cache()
+{
+    pthread_mutex_lock(&program_cache_mutex);
+    for (int bucket = 0; bucket < PROGRAM_CACHE_BUCKETS; bucket++)
+    {
+        // Reservas de leituras em andamento ficam: quem as criou as retira ao terminar.
+        Program **link = &program_cache[bucket];
+        while (*link != NULL)
+        {
+            Program *program = *link;
+            if (program->is_loading)
+            {
+                link = &program->next_in_bucket;
+                continue;
+            }
+            *link = program->next_in_bucket;
+            Program__release(program);
+        }
+    }
+    pthread_mutex_unlock(&program_cache_mutex);
+}
+
+void Program__print_cache_stats(FILE *output)
+{
+    pthread_mutex_lock(&program_cache_mutex);
+    fprintf(output, "Cache de programas : %lld pedidos, %lld arquivo(s) lido(s) (%lld reaproveitados, %lld com erro)\n",
+            cache_requests, cache_loads, cache_requests - cache_loads - cache_failures, cache_failures);
+    pthread_mutex_unlock(&program_cache_mutex);
+}
@@ -0,0 +1,132 @@
+#ifndef PROGRAM_H_GUARD
+#define PROGRAM_H_GUARD
+
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+// -----------------------------------------------------------------------------
+// Programa compilado: o conteúdo de um arquivo .synt já interpretado.
+//
+// Blocos 'repeat <n> { ... }' ficam no vetor como um par de marcadores em volta
+// do corpo, expandidos só durante a execução: o programa ocupa o tamanho do texto,
+// não o do traço que ele descreve.
+//
+// Um programa pode vir do texto .synt ou do formato binário .syntb (gerado pela
+// ferramenta syntc), reconhecido pela assinatura "SYNB" no início do arquivo.
+// O .syntb é mapeado em memória e suas instruções são usadas sem cópia.
+//
+// Programas são imutáveis depois de carregados e compartilhados, somente para
+// leitura, por todos os processos que os executam. Um cache indexado por
+// caminho + mtime garante que cada arquivo seja lido e interpretado uma única
+// vez enquanto não for modificado; cada BCP mantém uma referência ao programa.
+// -----------------------------------------------------------------------------
+
+// Enumeração dos códigos de operação suportados por instruções de processo
+typedef enum
+{
+    OP_CODE_EXEC = 0,  // exec <tempo>
+    OP_CODE_READ = 1,  // read <trilha>
+    OP_CODE_WRITE = 2, // write <trilha>
+    OP_CODE_PRINT = 3, // print <tempo>
+    OP_CODE_SEM_P = 4, // P(<id>)
+    OP_CODE_SEM_V = 5, // V(<id>)
+    OP_CODE_REPEAT = 6,    // repeat <n> {   (operando: número de repetições)
+    OP_CODE_END_REPEAT = 7 // }              (operando: índice do 'repeat' correspondente)
+} OperationCodeValue;
+
+// Profundidade máxima de blocos 'repeat' aninhados
+#define PROGRAM_MAX_LOOP_DEPTH 8
+
+// Estrutura de uma instrução de processo (8 bytes). O programa de cada processo é
+// um vetor contíguo destas, indexado diretamente pelo Program Counter.
+typedef struct Instruction_s
+{
+    int value_operand;         // Operando numérico (tempo, trilha, etc.)
+    unsigned char op_code_val; // Código da operação (OperationCodeValue)
+    char semaphore_id_char;    // Identificador do semáforo (se aplicável)
+} Instruction;
+
+// Metadados derivados das instruções na mesma passada da leitura, para que os
+// demais módulos (ex: memória) não precisem reler o arquivo. Instruções dentro de
+// blocos 'repeat' contam uma vez por repetição (com saturação).
+#define PROGRAM_MAX_SEMAPHORES_USED 63
+
+typedef struct
+{
+    long long total_exec_time;                             // Soma dos operandos de 'exec'
+    int read_count;                                        // Instruções 'read'
+    int write_count;                                       // Instruções 'write'
+    int print_count;                                       // Instruções 'print'
+    int semaphore_op_count;                                // Instruções P e V
+    int pages_required;                                    // Páginas virtuais para o tempo total de 'exec'
+    char semaphores_used[PROGRAM_MAX_SEMAPHORES_USED + 1]; // Semáforos distintos usados em P/V (ex: "SR")
+} ProgramMetadata;
+
+// Estrutura de um programa compilado
+typedef struct Program_t
+{
+    char *path;                  // Caminho do arquivo de origem (chave do cache)
+    struct timespec mtime;       // Data de modificação do arquivo quando foi lido
+    long long file_size;         // Tamanho do arquivo quando foi lido
+    char *name_str;              // Nome do processo
+    int segment_identifier;      // Identificador do segmento de memória
+    int priority_level;          // Prioridade
+    int segment_size_bytes;      // Tamanho do segmento em bytes
+    char *semaphore_ids;         // Linha de semáforos usados (ex: "S R")
+    Instruction *instructions;   // Vetor contíguo de instruções
+    void *mapping;               // Mapeamento do .syntb de onde vêm as instruções (NULL para texto)
+    size_t mapping_size;         // Tamanho do mapeamento
+    int instruction_count;       // Quantidade de instruções
+    ProgramMetadata metadata;    // Metadados derivados das instruções
+    int reference_count;         // Referências vivas: o cache e cada BCP (atualizado atomicamente)
+    int is_loading;              // 1 na entrada reservada no cache enquanto o arquivo é lido
+    struct Program_t *next_in_bucket;
+} Program;
+
+/**
+ * @brief Obtém o programa de um arquivo .synt, lendo-o apenas se ele não estiver no
+ * cache ou tiver sido modificado desde a última leitura.
+ * @param synthetic_file_path Caminho do arquivo.
+ * @param error_message Recebe a descrição do erro, com o número da linha (pode ser NULL).
+ * @param error_size Tamanho do buffer de erro.
+ * @return Programa com uma referência para o chamador, ou NULL se o arquivo não puder ser lido.
+ */
+Program *Program__acquire(const char *synthetic_file_path, char *error_message, size_t error_size);
+
+/**
+ * @brief Acrescenta 'count' referências a um programa que o chamador já referencia
+ * (ex: ao clonar um processo), sem consultar o cache nem o arquivo.
+ */
+void Program__retain(Program *program, int count);
+
+/**
+ * @brief Devolve uma referência obtida com Program__acquire. O programa é liberado
+ * quando a última referência é devolvida.
+ */
+void Program__release(Program *program);
+
+/**
+ * @brief Lê um arquivo de programa (.synt ou .syntb) sem passar pelo cache.
+ * @return Programa com uma única referência (liberar com Program__release), ou NULL em caso de erro.
+ */
+Program *Program__load_file(const char *file_path, char *error_message, size_t error_size);
+
+/**
+ * @brief Grava um programa no formato binário .syntb.
+ * @return 0 em caso de sucesso, -1 em caso de erro (descrito em 'error_message').
+ */
+int Program__write_binary(const Program *program, const char *output_path, char *error_message, size_t error_size);
+
+/**
+ * @brief Descarta todos os programas do cache (os que ainda estão em uso por algum
+ * processo só são liberados quando ele terminar).
+ */
+void Program__clear_cache();
+
+/**
+ * @brief Imprime as estatísticas do cache (pedidos, acertos e arquivos lidos).
+ */
+void Program__print_cache_stats(FILE *output);
+
+#endif // PROGRAM_H_GUARD
@@ -40,7 +40,7 @@ int semaphore_P_operation(Semaphore *sem_instance, Bcp *requesting_process_bcp)
     int was_blocked_flag = 0;
     if (sem_instance->current_value < 0)
     {
-        requesting_process_bcp->current_execution_state = PROCESS_STATE_WAITING;
+        Process__block(requesting_process_bcp, METRICS_WAIT_SEMAPHORE);
         add_to_list(sem_instance->waiting_processes_q, requesting_process_bcp);
         was_blocked_flag = 1;
     }
@@ -68,13 +68,15 @@ void semaphore_V_operation(Semaphore *sem_instance)
         {
             Bcp *process_to_wake = (Bcp *)first_waiting_node->data;
 
-            remove_from_list(sem_instance->waiting_processes_q, process_to_wake, compare_pid);
+            remove_first_from_list(sem_instance->waiting_processes_q); // O primeiro da fila, em O(1)
 
-            process_to_wake->current_execution_state = PROCESS_STATE_READY;
+            Process__set_state(process_to_wake, PROCESS_STATE_READY);
 
-            if (kernel_instance && kernel_instance->scheduler && kernel_instance->scheduler->ready_queue)
+            if (kernel_instance && kernel_instance->scheduler)
             {
-                add_to_list(kernel_instance->scheduler->ready_queue, process_to_wake);
+                pthread_mutex_lock(&kernel_instance->scheduler->ready_queue_mutex);
+                Scheduler__add_ready_process(process_to_wake, SCHED_ENQUEUE_WAKEUP);
+                pthread_mutex_unlock(&kernel_instance->scheduler->ready_queue_mutex);
             }
         }
     }
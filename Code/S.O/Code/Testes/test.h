@@ -0,0 +1,56 @@
+#ifndef TEST_H_GUARD
+#define TEST_H_GUARD
+
+#include <stdio.h>
+#include <stddef.h>
+
+// -----------------------------------------------------------------------------
+// Testes unitários do simulador (make test).
+//
+// Cada suíte é uma função que exercita um módulo pela sua interface pública e
+// registra as verificações com CHECK. O executável termina com status 1 se
+// alguma verificação falhar.
+// -----------------------------------------------------------------------------
+
+// Contadores das verificações (definidos em test_main.c)
+extern int test_check_count;
+extern int test_failure_count;
+
+// Verifica uma condição; em caso de falha, imprime o local e a expressão e segue adiante.
+#define CHECK(condition)                                                        \
+    do                                                                          \
+    {                                                                           \
+        test_check_count++;                                                     \
+        if (!(condition))                                                       \
+        {                                                                       \
+            test_failure_count++;                                               \
+            fprintf(stderr, "FALHA %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+        }                                                                       \
+    } while (0)
+
+/**
+ * @brief Cria (ou sobrescreve) um arquivo no diretório temporário dos testes.
+ * @param name Nome do arquivo, sem diretório.
+ * @param content Conteúdo gravado.
+ * @param path_buffer Recebe o caminho completo do arquivo.
+ * @return 1 em caso de sucesso, 0 caso contrário.
+ */
+int Test__write_file(const char *name, const char *content, char *path_buffer, size_t buffer_size);
+
+/**
+ * @brief Como Test__write_file, para conteúdo binário de 'size' bytes.
+ */
+int Test__write_bytes(const char *name, const void *bytes, size_t size, char *path_buffer, size_t buffer_size);
+
+/* ---------- Suítes ---------- */
+
+void Test__program_cache();
+void Test__program_parser();
+void Test__program_binary();
+void Test__program_repeat();
+void Test__process_table();
+void Test__ready_queue();
+void Test__rbtree();
+void Test__fusion_digest();
+
+#endif // TEST_H_GUARD
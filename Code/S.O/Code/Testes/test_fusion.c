@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------------
+// Regressão da fusão de 'exec' (CPU/cpu.c): no modo determinístico, o
+// escalonamento com rajadas fundidas deve ser idêntico ao de --no-fusion.
+//
+// Cada simulação roda num fork próprio, como no benchmark de ponta a ponta:
+// o kernel e suas threads são únicos por processo.
+// -----------------------------------------------------------------------------
+#include "test.h"
+#include "../Interface/headless.h"
+#include "../Nucleo/config.h"
+#include "../Clock/timescale.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define SIMULATION_TIMEOUT_S 60
+#define MIXED_PROCESS_COUNT 24
+
+// Programa com rajadas de 'exec' intercaladas com E/S e uma seção crítica, para que
+// processos sejam preemptados no meio de rajadas fundidas.
+static const char *MIXED_PROGRAM =
+    "misto\n"
+    "9\n"
+    "2\n"
+    "8\n"
+    "m\n"
+    "exec 30\n"
+    "exec 45\n"
+    "exec 10\n"
+    "read 4\n"
+    "exec 25\n"
+    "exec 25\n"
+    "P(m)\n"
+    "exec 15\n"
+    "exec 5\n"
+    "V(m)\n"
+    "print 7\n"
+    "exec 60\n"
+    "exec 1\n"
+    "write 9\n";
+
+// Resultado de uma simulação, enviado pelo processo filho.
+typedef struct
+{
+    int terminated_count;
+    unsigned long long schedule_digest;
+} SimulationOutcome;
+
+// Simula 'paths' (com 'copies' processos de cada, ou um se NULL) num processo filho,
+// com ou sem fusão. Retorna 0 em caso de sucesso.
+static int simulate_in_child(const char *const *paths, const int *copies, int path_count, int fuse_exec,
+                             SimulationOutcome *outcome)
+{
+    int outcome_pipe[2];
+    if (pipe(outcome_pipe) != 0)
+        return -1;
+    fflush(NULL);
+    pid_t child = fork();
+    if (child < 0)
+    {
+        close(outcome_pipe[0]);
+        close(outcome_pipe[1]);
+        return -1;
+    }
+    if (child == 0)
+    {
+        close(outcome_pipe[0]);
+        alarm(SIMULATION_TIMEOUT_S);
+        kernel_config.deterministic = 1;
+        kernel_config.fuse_exec = fuse_exec;
+        Timescale__configure("afap");
+
+        // O kernel assume a posse dos caminhos.
+        char **owned_paths = malloc(sizeof(char *) * path_count);
+        for (int i = 0; i < path_count; i++)
+            owned_paths[i] = strdup(paths[i]);
+        HeadlessReport report;
+        Headless__simulate(owned_paths, copies, path_count, &report);
+        free(owned_paths);
+
+        SimulationOutcome result = {report.terminated_count, report.schedule_digest};
+        ssize_t written = write(outcome_pipe[1], &result, sizeof(result));
+        _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+    }
+
+    close(outcome_pipe[1]);
+    ssize_t received = read(outcome_pipe[0], outcome, sizeof(*outcome));
+    close(outcome_pipe[0]);
+    int status;
+    waitpid(child, &status, 0);
+    return (received == (ssize_t)sizeof(*outcome) && WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+}
+
+// Compara o escalonamento de uma carga com e sem fusão.
+static void check_same_schedule(const char *const *paths, const int *copies, int path_count)
+{
+    int process_count = 0;
+    for (int i = 0; i < path_count; i++)
+        process_count += copies ? copies[i] : 1;
+    SimulationOutcome fused, unfused;
+    CHECK(simulate_in_child(paths, copies, path_count, 1, &fused) == 0);
+    CHECK(simulate_in_child(paths, copies, path_count, 0, &unfused) == 0);
+    CHECK(fused.terminated_count == process_count);
+    CHECK(fused.terminated_count == unfused.terminated_count);
+    CHECK(fused.schedule_digest == unfused.schedule_digest);
+}
+
+void Test__fusion_digest()
+{
+    // Os programas de exemplo do repositório (make test roda na raiz do projeto).
+    static const char *const example_paths[] = {
+        "synt/synt1", "synt/synt2", "synt/synt3", "synt/synt4", "synt/synt5",
+        "synt/synt6", "synt/synt7", "synt/synt8", "synt/synt9", "synt/synt10",
+    };
+    check_same_schedule(example_paths, NULL, (int)(sizeof(example_paths) / sizeof(example_paths[0])));
+
+    // Muitas réplicas de um programa com rajadas longas disputando CPU, disco e semáforo.
+    char mixed_path[512];
+    CHECK(Test__write_file("mixed.synt", MIXED_PROGRAM, mixed_path, sizeof(mixed_path)));
+    const char *mixed_paths[MIXED_PROCESS_COUNT];
+    for (int i = 0; i < MIXED_PROCESS_COUNT; i++)
+        mixed_paths[i] = mixed_path;
+    check_same_schedule(mixed_paths, NULL, MIXED_PROCESS_COUNT);
+
+    // As mesmas réplicas criadas por cópia de um processo modelo (--spawn).
+    const char *spawn_path[] = {mixed_path};
+    const int spawn_copies[] = {MIXED_PROCESS_COUNT};
+    check_same_schedule(spawn_path, spawn_copies, 1);
+}
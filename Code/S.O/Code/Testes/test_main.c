@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------
+// Executor dos testes unitários.
+//
+// Uso: ./icarus_tests
+// -----------------------------------------------------------------------------
+#include "test.h"
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+int test_check_count = 0;
+int test_failure_count = 0;
+
+static char temporary_directory[] = "/tmp/icarus_tests_XXXXXX";
+
+int Test__write_bytes(const char *name, const void *bytes, size_t size, char *path_buffer, size_t buffer_size)
+{
+    snprintf(path_buffer, buffer_size, "%s/%s", temporary_directory, name);
+    FILE *file = fopen(path_buffer, "wb");
+    if (file == NULL)
+        return 0;
+    size_t written = fwrite(bytes, 1, size, file);
+    return fclose(file) == 0 && written == size;
+}
+
+int Test__write_file(const char *name, const char *content, char *path_buffer, size_t buffer_size)
+{
+    return Test__write_bytes(name, content, strlen(content), path_buffer, buffer_size);
+}
+
+// Apaga o diretório temporário e os arquivos criados pelas suítes.
+static void remove_temporary_directory()
+{
+    DIR *directory = opendir(temporary_directory);
+    if (directory != NULL)
+    {
+        struct dirent *entry;
+        while ((entry = readdir(directory)) != NULL)
+        {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+                continue;
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s", temporary_directory, entry->d_name);
+            unlink(path);
+        }
+        closedir(directory);
+    }
+    rmdir(temporary_directory);
+}
+
+// Executa uma suíte e informa quantas verificações falharam nela.
+static void run_suite(const char *name, void (*suite)())
+{
+    int failures_before = test_failure_count;
+    suite();
+    printf("%-28s %s\n", name, test_failure_count == failures_before ? "ok" : "FALHOU");
+}
+
+int main()
+{
+    if (mkdtemp(temporary_directory) == NULL)
+    {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    run_suite("cache de programas", Test__program_cache);
+    run_suite("leitura de .synt", Test__program_parser);
+    run_suite("formato .syntb", Test__program_binary);
+    run_suite("blocos repeat", Test__program_repeat);
+    run_suite("tabela de processos", Test__process_table);
+    run_suite("fila de prontos", Test__ready_queue);
+    run_suite("arvore rubro-negra", Test__rbtree);
+    run_suite("fusao de exec (digest)", Test__fusion_digest);
+
+    remove_temporary_directory();
+    printf("%d verificacoes, %d falha(s)\n", test_check_count, test_failure_count);
+    return test_failure_count == 0 ? 0 : 1;
+}
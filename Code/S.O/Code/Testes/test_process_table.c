@@ -0,0 +1,153 @@
+// -----------------------------------------------------------------------------
+// Testes da tabela de processos (Nucleo/process_table.c).
+// -----------------------------------------------------------------------------
+#include "test.h"
+#include "../Nucleo/process_table.h"
+#include "../Process/process.h"
+#include <stdlib.h>
+
+#define STRESS_PROCESS_COUNT 1000
+#define STRESS_OPERATIONS 50000
+
+// Gerador pseudoaleatório fixo, para que uma falha seja reproduzível.
+static unsigned int next_random(unsigned int *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 16;
+}
+
+// Verifica que a iteração percorre exatamente 'expected' (na ordem dada).
+static int iterates_in_order(const ProcessTable *table, Bcp **expected, int count)
+{
+    int position = 0;
+    for (Bcp *process = ProcessTable__first(table); process != NULL; process = ProcessTable__next(table, process))
+    {
+        if (position >= count || process != expected[position])
+            return 0;
+        position++;
+    }
+    return position == count;
+}
+
+static void check_generation_handles()
+{
+    ProcessTable table;
+    ProcessTable__init(&table);
+    Program program = {.priority_level = 4};
+    Bcp *processes = calloc(3, sizeof(Bcp));
+    for (int i = 0; i < 3; i++)
+    {
+        processes[i].pid = i + 1;
+        processes[i].program = &program;
+    }
+
+    ProcessHandle first = ProcessTable__insert(&table, &processes[0]);
+    ProcessHandle second = ProcessTable__insert(&table, &processes[1]);
+    CHECK(first.generation != 0 && second.generation != 0);
+    CHECK(processes[0].table_handle.slot == first.slot && processes[0].table_handle.generation == first.generation);
+    CHECK(ProcessTable__get(&table, first) == &processes[0]);
+    CHECK(ProcessTable__count(&table) == 2);
+
+    // Os campos quentes ficam nas colunas do slot.
+    CHECK(Process__get_state(&processes[0]) == PROCESS_STATE_NEW);
+    CHECK(Process__get_priority(&processes[1]) == 4);
+    Process__set_state(&processes[1], PROCESS_STATE_READY);
+    int state_counts[PROCESS_STATE_RUNNING + 1];
+    ProcessTable__count_states(&table, state_counts, PROCESS_STATE_RUNNING + 1);
+    CHECK(state_counts[PROCESS_STATE_NEW] == 1 && state_counts[PROCESS_STATE_READY] == 1);
+
+    // Um handle removido deixa de valer, mesmo depois que o slot é reaproveitado.
+    CHECK(ProcessTable__remove(&table, first) == 1);
+    CHECK(ProcessTable__get(&table, first) == NULL);
+    CHECK(ProcessTable__remove(&table, first) == 0);
+    ProcessHandle third = ProcessTable__insert(&table, &processes[2]);
+    CHECK(third.slot == first.slot && third.generation != first.generation);
+    CHECK(ProcessTable__get(&table, first) == NULL);
+    CHECK(ProcessTable__remove(&table, first) == 0);
+    CHECK(ProcessTable__get(&table, third) == &processes[2]);
+    CHECK(ProcessTable__find_pid(&table, 1) == NULL);
+    CHECK(ProcessTable__find_pid(&table, 3) == &processes[2]);
+
+    // O slot reaproveitado entra no fim da ordem de inserção.
+    Bcp *order[] = {&processes[1], &processes[2]};
+    CHECK(iterates_in_order(&table, order, 2));
+
+    ProcessTable__destroy(&table);
+    free(processes);
+}
+
+// Inserções e remoções aleatórias conferidas contra um vetor sombra. As remoções
+// recuam entradas nas sequências de sondagem do índice de PIDs; uma entrada
+// recuada errado deixa de ser encontrada por find_pid.
+static void check_pid_index_against_shadow()
+{
+    ProcessTable table;
+    ProcessTable__init(&table);
+    Program program = {.priority_level = 1};
+    Bcp *processes = calloc(STRESS_PROCESS_COUNT, sizeof(Bcp));
+    int *present = calloc(STRESS_PROCESS_COUNT, sizeof(int));
+    for (int i = 0; i < STRESS_PROCESS_COUNT; i++)
+    {
+        processes[i].pid = i * 7 + 1; // PIDs espaçados também geram colisões
+        processes[i].program = &program;
+    }
+
+    unsigned int state = 42;
+    int live_count = 0;
+    int mismatches = 0;
+    for (int operation = 0; operation < STRESS_OPERATIONS; operation++)
+    {
+        int i = (int)(next_random(&state) % STRESS_PROCESS_COUNT);
+        if (present[i])
+        {
+            if (ProcessTable__remove(&table, processes[i].table_handle) != 1)
+                mismatches++;
+            present[i] = 0;
+            live_count--;
+        }
+        else
+        {
+            if (ProcessTable__insert(&table, &processes[i]).generation == 0)
+                mismatches++;
+            present[i] = 1;
+            live_count++;
+        }
+
+        // Confere uma amostra a cada operação e tudo periodicamente.
+        int sample = (int)(next_random(&state) % STRESS_PROCESS_COUNT);
+        if (ProcessTable__find_pid(&table, processes[sample].pid) != (present[sample] ? &processes[sample] : NULL))
+            mismatches++;
+        if (operation % 1000 == 0)
+        {
+            for (int j = 0; j < STRESS_PROCESS_COUNT; j++)
+                if (ProcessTable__find_pid(&table, processes[j].pid) != (present[j] ? &processes[j] : NULL))
+                    mismatches++;
+            if (ProcessTable__find_pid(&table, 0) != NULL)
+                mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(ProcessTable__count(&table) == live_count);
+
+    // Esvaziar a tabela não deixa nada no índice.
+    for (int i = 0; i < STRESS_PROCESS_COUNT; i++)
+        if (present[i])
+            ProcessTable__remove(&table, processes[i].table_handle);
+    CHECK(ProcessTable__count(&table) == 0);
+    CHECK(ProcessTable__first(&table) == NULL);
+    int leftovers = 0;
+    for (int i = 0; i < STRESS_PROCESS_COUNT; i++)
+        if (ProcessTable__find_pid(&table, processes[i].pid) != NULL)
+            leftovers++;
+    CHECK(leftovers == 0);
+
+    ProcessTable__destroy(&table);
+    free(present);
+    free(processes);
+}
+
+void Test__process_table()
+{
+    check_generation_handles();
+    check_pid_index_against_shadow();
+}
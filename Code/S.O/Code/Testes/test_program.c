@@ -0,0 +1,374 @@
+// -----------------------------------------------------------------------------
+// Testes do módulo de programas (Process/program.c).
+// -----------------------------------------------------------------------------
+#include "test.h"
+#include "../Process/program.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONCURRENT_LOADERS 8
+
+// Posições dos campos do cabeçalho .syntb (ver SyntbHeader em program.c).
+#define SYNTB_VERSION_OFFSET 4
+#define SYNTB_NAME_LENGTH_OFFSET 24
+#define SYNTB_INSTRUCTION_COUNT_OFFSET 32
+#define SYNTB_INSTRUCTIONS_OFFSET_OFFSET 36
+
+static const char *SMALL_PROGRAM =
+    "cache\n"
+    "7\n"
+    "1\n"
+    "4\n"
+    "S\n"
+    "exec 10\n"
+    "P(S)\n"
+    "read 3\n"
+    "V(S)\n";
+
+// Thread que pede o mesmo arquivo ao cache que as demais.
+static void *acquire_in_thread(void *path)
+{
+    char error[256];
+    return Program__acquire((const char *)path, error, sizeof(error));
+}
+
+// Tenta carregar 'content' e verifica que a leitura falha com uma mensagem que contém 'expected_error'.
+static int load_fails_with(const char *content, const char *expected_error)
+{
+    char path[512];
+    char error[256] = "";
+    if (!Test__write_file("invalid.synt", content, path, sizeof(path)))
+        return 0;
+    Program *program = Program__acquire(path, error, sizeof(error));
+    if (program != NULL)
+    {
+        Program__release(program);
+        return 0;
+    }
+    if (strstr(error, expected_error) == NULL)
+    {
+        fprintf(stderr, "mensagem inesperada: %s\n", error);
+        return 0;
+    }
+    return 1;
+}
+
+void Test__program_cache()
+{
+    char path[512];
+    char error[256];
+    CHECK(Test__write_file("cache.synt", SMALL_PROGRAM, path, sizeof(path)));
+
+    // Pedidos repetidos devolvem o mesmo programa, com uma referência a mais por pedido.
+    Program *first = Program__acquire(path, error, sizeof(error));
+    Program *second = Program__acquire(path, error, sizeof(error));
+    CHECK(first != NULL);
+    CHECK(first == second);
+    CHECK(first != NULL && first->instruction_count == 4);
+    CHECK(first != NULL && first->reference_count == 3); // cache + dois pedidos
+    Program__release(second);
+
+    // Pedidos simultâneos de um arquivo novo compartilham uma única leitura.
+    char concurrent_path[512];
+    CHECK(Test__write_file("concurrent.synt", SMALL_PROGRAM, concurrent_path, sizeof(concurrent_path)));
+    pthread_t loaders[CONCURRENT_LOADERS];
+    for (int i = 0; i < CONCURRENT_LOADERS; i++)
+    {
+        pthread_create(&loaders[i], NULL, acquire_in_thread, concurrent_path);
+    }
+    Program *loaded[CONCURRENT_LOADERS];
+    for (int i = 0; i < CONCURRENT_LOADERS; i++)
+    {
+        pthread_join(loaders[i], (void **)&loaded[i]);
+    }
+    for (int i = 0; i < CONCURRENT_LOADERS; i++)
+    {
+        CHECK(loaded[i] != NULL && loaded[i] == loaded[0]);
+        Program__release(loaded[i]);
+    }
+
+    // Um arquivo modificado é lido de novo; quem tinha a versão antiga continua com ela.
+    CHECK(Test__write_file("cache.synt", "cache\n7\n1\n4\nS\nexec 10\nexec 20\nexec 30\nP(S)\nV(S)\n", path, sizeof(path)));
+    Program *modified = Program__acquire(path, error, sizeof(error));
+    CHECK(modified != NULL && modified != first);
+    CHECK(modified != NULL && modified->instruction_count == 5);
+    CHECK(first->instruction_count == 4);
+    Program__release(modified);
+    Program__release(first);
+
+    // Arquivo inexistente.
+    CHECK(Program__acquire("/nonexistent/icarus.synt", error, sizeof(error)) == NULL);
+
+    Program__clear_cache();
+}
+
+void Test__program_parser()
+{
+    // Cabeçalho incompleto: o erro aponta a linha que falta.
+    CHECK(load_fails_with("truncado\n7\n", ":3: fim de arquivo no cabecalho, esperado 'prioridade'"));
+    CHECK(load_fails_with("cabecalho\n7\nalta\n4\nS\n", ":3: valor invalido no cabecalho"));
+    CHECK(load_fails_with("", "arquivo vazio"));
+
+    // Operandos: estouro de int, ausência, sinal negativo e lixo após o valor.
+    CHECK(load_fails_with("estouro\n7\n1\n4\nS\nexec 2147483648\n", ":6: operando numerico invalido ou ausente"));
+    CHECK(load_fails_with("ausente\n7\n1\n4\nS\nexec 10\nread\n", ":7: operando numerico invalido ou ausente"));
+    CHECK(load_fails_with("negativo\n7\n1\n4\nS\nexec -50\n", ":6: operando negativo em 'exec -50'"));
+    CHECK(load_fails_with("negativo\n7\n1\n4\nS\nwrite -1\n", ":6: operando negativo"));
+    CHECK(load_fails_with("sobra\n7\n1\n4\nS\nprint 5 6\n", ":6: conteudo inesperado apos o operando"));
+
+    // Instruções desconhecidas e semáforos malformados.
+    CHECK(load_fails_with("desconhecida\n7\n1\n4\nS\njump 3\n", ":6: instrucao desconhecida 'jump'"));
+    CHECK(load_fails_with("semaforo\n7\n1\n4\nS\nP(S) 1\n", ":6: conteudo inesperado apos 'P(S)'"));
+
+    // O maior operando aceito e linhas com \r\n.
+    char path[512];
+    char error[256];
+    CHECK(Test__write_file("limits.synt", "limites\r\n7\r\n1\r\n4\r\nS\r\nexec 2147483647\r\n\r\nread 0\r\n", path,
+                           sizeof(path)));
+    Program *program = Program__acquire(path, error, sizeof(error));
+    CHECK(program != NULL);
+    if (program != NULL)
+    {
+        CHECK(program->instruction_count == 2);
+        CHECK(program->instructions[0].value_operand == 2147483647);
+        CHECK(program->instructions[1].op_code_val == OP_CODE_READ);
+        CHECK(strcmp(program->name_str, "limites") == 0);
+        Program__release(program);
+    }
+
+    // Arquivo inexistente.
+    CHECK(Program__acquire("/nonexistent/icarus.synt", error, sizeof(error)) == NULL);
+    CHECK(strstr(error, "arquivo nao encontrado") != NULL);
+
+    Program__clear_cache();
+}
+
+// Lê um arquivo inteiro para um buffer alocado com malloc.
+static char *read_whole_file(const char *path, size_t *size)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    *size = (size_t)ftell(file);
+    rewind(file);
+    char *bytes = malloc(*size);
+    if (bytes != NULL && fread(bytes, 1, *size, file) != *size)
+    {
+        free(bytes);
+        bytes = NULL;
+    }
+    fclose(file);
+    return bytes;
+}
+
+// Grava uma cópia de 'original' com 'value_size' bytes trocados a partir de 'offset' e
+// verifica que o carregamento falha com 'expected_error'.
+static int patched_binary_fails_with(const char *original, size_t size, size_t offset, const void *value,
+                                     size_t value_size, const char *expected_error)
+{
+    char *bytes = malloc(size);
+    memcpy(bytes, original, size);
+    memcpy(bytes + offset, value, value_size);
+    char path[512];
+    char error[256] = "";
+    int written = Test__write_bytes("patched.syntb", bytes, size, path, sizeof(path));
+    free(bytes);
+    Program *program = written ? Program__load_file(path, error, sizeof(error)) : NULL;
+    if (program != NULL)
+    {
+        Program__release(program);
+        return 0;
+    }
+    if (strstr(error, expected_error) == NULL)
+    {
+        fprintf(stderr, "mensagem inesperada: %s\n", error);
+        return 0;
+    }
+    return 1;
+}
+
+// Como patched_binary_fails_with, trocando um campo de 32 bits do cabeçalho.
+static int patched_field_fails_with(const char *original, size_t size, size_t offset, uint32_t value,
+                                    const char *expected_error)
+{
+    return patched_binary_fails_with(original, size, offset, &value, sizeof(value), expected_error);
+}
+
+void Test__program_binary()
+{
+    char text_path[512];
+    char binary_path[512];
+    char error[256];
+    CHECK(Test__write_file("binary.synt", SMALL_PROGRAM, text_path, sizeof(text_path)));
+    CHECK(Test__write_file("binary.syntb", "", binary_path, sizeof(binary_path)));
+
+    // Ida e volta: o .syntb reproduz o cabeçalho e as instruções do texto.
+    Program *text = Program__load_file(text_path, error, sizeof(error));
+    CHECK(text != NULL);
+    if (text == NULL)
+        return;
+    CHECK(Program__write_binary(text, binary_path, error, sizeof(error)) == 0);
+    Program *binary = Program__load_file(binary_path, error, sizeof(error));
+    CHECK(binary != NULL);
+    if (binary == NULL)
+    {
+        Program__release(text);
+        return;
+    }
+    CHECK(binary->mapping != NULL);
+    CHECK(strcmp(binary->name_str, "cache") == 0);
+    CHECK(binary->priority_level == 1);
+    CHECK(binary->instruction_count == text->instruction_count);
+    CHECK(memcmp(binary->instructions, text->instructions, sizeof(Instruction) * text->instruction_count) == 0);
+
+    // Regravar um .syntb em uso não altera o mapeamento de quem já o carregou
+    // (truncar o arquivo no lugar causaria SIGBUS ao ler as instruções).
+    char short_path[512];
+    CHECK(Test__write_file("short.synt", "curto\n1\n1\n1\nS\nexec 1\n", short_path, sizeof(short_path)));
+    Program *short_program = Program__load_file(short_path, error, sizeof(error));
+    CHECK(short_program != NULL);
+    if (short_program != NULL)
+    {
+        CHECK(Program__write_binary(short_program, binary_path, error, sizeof(error)) == 0);
+        Program__release(short_program);
+    }
+    CHECK(memcmp(binary->instructions, text->instructions, sizeof(Instruction) * text->instruction_count) == 0);
+    Program__release(binary);
+
+    // Arquivos corrompidos são rejeitados antes de qualquer instrução ser usada.
+    CHECK(Program__write_binary(text, binary_path, error, sizeof(error)) == 0);
+    size_t size = 0;
+    char *original = read_whole_file(binary_path, &size);
+    CHECK(original != NULL);
+    if (original != NULL)
+    {
+        char path[512];
+        CHECK(Test__write_bytes("truncated.syntb", original, 20, path, sizeof(path)));
+        CHECK(Program__load_file(path, error, sizeof(error)) == NULL);
+        CHECK(strstr(error, "cabecalho .syntb truncado") != NULL);
+
+        CHECK(patched_field_fails_with(original, size, SYNTB_VERSION_OFFSET, 99, "versao de .syntb nao suportada"));
+        CHECK(patched_field_fails_with(original, size, SYNTB_INSTRUCTIONS_OFFSET_OFFSET, (uint32_t)size,
+                                       "arquivo .syntb corrompido"));
+        CHECK(patched_field_fails_with(original, size, SYNTB_INSTRUCTIONS_OFFSET_OFFSET, 8, "arquivo .syntb corrompido"));
+        CHECK(patched_field_fails_with(original, size, SYNTB_INSTRUCTION_COUNT_OFFSET, 0x40000000u,
+                                       "arquivo .syntb corrompido"));
+        CHECK(patched_field_fails_with(original, size, SYNTB_NAME_LENGTH_OFFSET, 0xFFFFFFF0u, "arquivo .syntb corrompido"));
+
+        // Instruções: opcode fora da tabela e operando negativo.
+        uint32_t instructions_offset;
+        memcpy(&instructions_offset, original + SYNTB_INSTRUCTIONS_OFFSET_OFFSET, sizeof(instructions_offset));
+        Instruction bad_opcode = text->instructions[1];
+        bad_opcode.op_code_val = 200;
+        Instruction negative_exec = text->instructions[0];
+        negative_exec.value_operand = -50;
+        CHECK(patched_binary_fails_with(original, size, instructions_offset + sizeof(Instruction), &bad_opcode,
+                                        sizeof(Instruction), "instrucao 1"));
+        CHECK(patched_binary_fails_with(original, size, instructions_offset, &negative_exec, sizeof(Instruction),
+                                        "instrucao 0"));
+        free(original);
+    }
+    Program__release(text);
+}
+
+// Carrega um programa de teste a partir do texto das instruções (cabeçalho fixo).
+static Program *load_instructions(const char *name, const char *instructions_text, char *path, size_t path_size)
+{
+    char content[1024];
+    char error[256];
+    snprintf(content, sizeof(content), "%s\n3\n1\n4\nQ\n%s", name, instructions_text);
+    if (!Test__write_file(name, content, path, path_size))
+        return NULL;
+    Program *program = Program__load_file(path, error, sizeof(error));
+    if (program == NULL)
+        fprintf(stderr, "%s\n", error);
+    return program;
+}
+
+void Test__program_repeat()
+{
+    char path[512];
+    char error[256];
+
+    // Blocos aninhados: o '}' guarda o índice do seu 'repeat' e os metadados contam as repetições.
+    Program *nested = load_instructions("nested.synt", "repeat 3 {\nexec 10\nrepeat 2 {\nread 1\n}\n}\n", path,
+                                        sizeof(path));
+    CHECK(nested != NULL);
+    if (nested != NULL)
+    {
+        CHECK(nested->instruction_count == 6);
+        CHECK(nested->instructions[0].op_code_val == OP_CODE_REPEAT && nested->instructions[0].value_operand == 3);
+        CHECK(nested->instructions[4].op_code_val == OP_CODE_END_REPEAT && nested->instructions[4].value_operand == 2);
+        CHECK(nested->instructions[5].op_code_val == OP_CODE_END_REPEAT && nested->instructions[5].value_operand == 0);
+        CHECK(nested->metadata.total_exec_time == 30);
+        CHECK(nested->metadata.read_count == 6);
+
+        // A mesma estrutura sobrevive à ida e volta pelo .syntb.
+        char binary_path[512];
+        CHECK(Test__write_file("nested.syntb", "", binary_path, sizeof(binary_path)));
+        CHECK(Program__write_binary(nested, binary_path, error, sizeof(error)) == 0);
+        Program *binary = Program__load_file(binary_path, error, sizeof(error));
+        CHECK(binary != NULL);
+        if (binary != NULL)
+        {
+            CHECK(binary->metadata.total_exec_time == 30);
+            CHECK(binary->metadata.read_count == 6);
+            Program__release(binary);
+        }
+
+        // .syntb com índices de bloco inconsistentes: a execução confia neles.
+        size_t size = 0;
+        char *original = read_whole_file(binary_path, &size);
+        CHECK(original != NULL);
+        if (original != NULL)
+        {
+            uint32_t instructions_offset;
+            memcpy(&instructions_offset, original + SYNTB_INSTRUCTIONS_OFFSET_OFFSET, sizeof(instructions_offset));
+            Instruction wrong_begin = nested->instructions[5];
+            wrong_begin.value_operand = 1; // Não é um 'repeat'
+            CHECK(patched_binary_fails_with(original, size, instructions_offset + 5 * sizeof(Instruction), &wrong_begin,
+                                            sizeof(Instruction), "instrucao 5 invalida"));
+            Instruction crossed = nested->instructions[4];
+            crossed.value_operand = 0; // Fecha o bloco externo antes do interno
+            CHECK(patched_binary_fails_with(original, size, instructions_offset + 4 * sizeof(Instruction), &crossed,
+                                            sizeof(Instruction), "instrucao 4 invalida"));
+            Instruction zero_repetitions = nested->instructions[2];
+            zero_repetitions.value_operand = 0;
+            CHECK(patched_binary_fails_with(original, size, instructions_offset + 2 * sizeof(Instruction),
+                                            &zero_repetitions, sizeof(Instruction), "instrucao 2 invalida"));
+            Instruction open_block = nested->instructions[1]; // O '}' externo vira um 'exec'
+            CHECK(patched_binary_fails_with(original, size, instructions_offset + 5 * sizeof(Instruction), &open_block,
+                                            sizeof(Instruction), "bloco 'repeat' sem fim"));
+            free(original);
+        }
+        Program__release(nested);
+    }
+
+    // 'repeat 0' e blocos vazios são descartados, sem deixar semáforos nos metadados.
+    Program *dropped = load_instructions("dropped.synt", "exec 5\nrepeat 0 {\nP(Q)\nexec 100\nV(Q)\n}\nrepeat 4 {\n}\n",
+                                         path, sizeof(path));
+    CHECK(dropped != NULL);
+    if (dropped != NULL)
+    {
+        CHECK(dropped->instruction_count == 1);
+        CHECK(dropped->metadata.total_exec_time == 5);
+        CHECK(dropped->metadata.semaphore_op_count == 0);
+        CHECK(dropped->metadata.semaphores_used[0] == '\0');
+        Program__release(dropped);
+    }
+
+    // Erros de aninhamento apontam a linha do problema.
+    CHECK(load_fails_with("fechamento\n3\n1\n4\nQ\nexec 1\n}\n", ":7: '}' sem 'repeat' correspondente"));
+    CHECK(load_fails_with("aberto\n3\n1\n4\nQ\nexec 1\nrepeat 2 {\nrepeat 2 {\nexec 1\n}\n",
+                          ":7: bloco 'repeat' sem '}'"));
+    CHECK(load_fails_with("fundo\n3\n1\n4\nQ\nrepeat 2 {\nrepeat 2 {\nrepeat 2 {\nrepeat 2 {\nrepeat 2 {\n"
+                          "repeat 2 {\nrepeat 2 {\nrepeat 2 {\nrepeat 2 {\nexec 1\n}\n}\n}\n}\n}\n}\n}\n}\n}\n",
+                          ":14: blocos 'repeat' aninhados demais"));
+    CHECK(load_fails_with("negativo\n3\n1\n4\nQ\nrepeat -1 {\n}\n", ":6: numero de repeticoes invalido"));
+    CHECK(load_fails_with("chave\n3\n1\n4\nQ\nrepeat 2\nexec 1\n}\n", ":6: esperado '{' ao final de"));
+
+    Program__clear_cache();
+}
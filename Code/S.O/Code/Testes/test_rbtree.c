@@ -0,0 +1,148 @@
+// -----------------------------------------------------------------------------
+// Testes da árvore rubro-negra (Ferramentas/rbtree.c).
+//
+// Depois de cada remoção, a árvore inteira é conferida: ordem, ponteiros para o
+// pai, raiz preta, nenhum vermelho com filho vermelho e a mesma quantidade de
+// pretos em todo caminho até as folhas. São as propriedades que os ajustes
+// (rotações e recolorações) da remoção precisam restaurar.
+// -----------------------------------------------------------------------------
+#include "test.h"
+#include "../Ferramentas/rbtree.h"
+#include <stdlib.h>
+
+#define TREE_ITEM_COUNT 2000
+#define TREE_OPERATIONS 40000
+
+typedef struct
+{
+    int key;
+    int in_tree;
+    RbNode node;
+} TreeItem;
+
+// Gerador pseudoaleatório fixo, para que uma falha seja reproduzível.
+static unsigned int next_random(unsigned int *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 16;
+}
+
+static int compare_items(const RbNode *a, const RbNode *b)
+{
+    int key_a = RBTREE_ENTRY(a, TreeItem, node)->key;
+    int key_b = RBTREE_ENTRY(b, TreeItem, node)->key;
+    return key_a < key_b ? -1 : (key_a > key_b);
+}
+
+// Confere a subárvore e retorna sua altura preta, ou -1 se alguma propriedade falhar.
+static int subtree_black_height(const RbNode *node, const RbNode *parent, int *count)
+{
+    if (node == NULL)
+        return 1;
+    if (node->parent != parent)
+        return -1;
+    if (node->is_red && ((node->left && node->left->is_red) || (node->right && node->right->is_red)))
+        return -1;
+    if (node->left && compare_items(node->left, node) >= 0)
+        return -1;
+    if (node->right && compare_items(node->right, node) <= 0)
+        return -1;
+    int left_height = subtree_black_height(node->left, node, count);
+    int right_height = subtree_black_height(node->right, node, count);
+    if (left_height < 0 || left_height != right_height)
+        return -1;
+    (*count)++;
+    return left_height + (node->is_red ? 0 : 1);
+}
+
+static int tree_is_valid(const RbTree *tree)
+{
+    if (tree->root != NULL && tree->root->is_red)
+        return 0;
+    int count = 0;
+    if (subtree_black_height(tree->root, NULL, &count) < 0 || count != tree->size)
+        return 0;
+    // O menor nó em cache e a iteração em ordem percorrem todos os nós.
+    const RbNode *smallest = tree->root;
+    while (smallest != NULL && smallest->left != NULL)
+        smallest = smallest->left;
+    if (rbtree_first(tree) != smallest)
+        return 0;
+    int visited = 0;
+    for (const RbNode *node = rbtree_first(tree); node != NULL; node = rbtree_next(node))
+        visited++;
+    return visited == tree->size;
+}
+
+// Insere as chaves 0..count-1 e as remove na ordem de 'order'.
+static int removes_in_order(TreeItem *items, int count, const int *order)
+{
+    RbTree tree;
+    rbtree_init(&tree, compare_items);
+    for (int i = 0; i < count; i++)
+    {
+        items[i].key = i;
+        rbtree_insert(&tree, &items[i].node);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        rbtree_remove(&tree, &items[order[i]].node);
+        if (!tree_is_valid(&tree))
+            return 0;
+    }
+    return tree.root == NULL && tree.size == 0 && rbtree_first(&tree) == NULL;
+}
+
+void Test__rbtree()
+{
+    TreeItem *items = calloc(TREE_ITEM_COUNT, sizeof(TreeItem));
+    int *order = malloc(sizeof(int) * TREE_ITEM_COUNT);
+
+    // Remoções sempre do menor, sempre do maior e sempre da raiz (nó com dois filhos).
+    for (int i = 0; i < TREE_ITEM_COUNT; i++)
+        order[i] = i;
+    CHECK(removes_in_order(items, TREE_ITEM_COUNT, order));
+    for (int i = 0; i < TREE_ITEM_COUNT; i++)
+        order[i] = TREE_ITEM_COUNT - 1 - i;
+    CHECK(removes_in_order(items, TREE_ITEM_COUNT, order));
+    RbTree tree;
+    rbtree_init(&tree, compare_items);
+    for (int i = 0; i < TREE_ITEM_COUNT; i++)
+    {
+        items[i].key = i;
+        rbtree_insert(&tree, &items[i].node);
+    }
+    int root_removals_valid = 1;
+    while (tree.root != NULL)
+    {
+        rbtree_remove(&tree, tree.root);
+        root_removals_valid = root_removals_valid && tree_is_valid(&tree);
+    }
+    CHECK(root_removals_valid);
+
+    // Inserções e remoções aleatórias, com chaves em ordem embaralhada.
+    unsigned int state = 1234;
+    for (int i = 0; i < TREE_ITEM_COUNT; i++)
+    {
+        items[i].key = (int)((i * 7919u) % TREE_ITEM_COUNT);
+        items[i].in_tree = 0;
+    }
+    rbtree_init(&tree, compare_items);
+    int invalid_count = 0;
+    for (int operation = 0; operation < TREE_OPERATIONS; operation++)
+    {
+        TreeItem *item = &items[next_random(&state) % TREE_ITEM_COUNT];
+        if (item->in_tree)
+            rbtree_remove(&tree, &item->node);
+        else
+            rbtree_insert(&tree, &item->node);
+        item->in_tree = !item->in_tree;
+        if (operation % 50 == 0 && !tree_is_valid(&tree))
+            invalid_count++;
+    }
+    CHECK(invalid_count == 0);
+    CHECK(tree_is_valid(&tree));
+
+    free(order);
+    free(items);
+}
@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------------
+// Testes da fila de prontos (escalonador/ready_queue.c).
+// -----------------------------------------------------------------------------
+#include "test.h"
+#include "../escalonador/ready_queue.h"
+#include "../Process/process.h"
+#include <stdlib.h>
+
+#define QUEUE_PROCESS_COUNT 300
+#define QUEUE_OPERATIONS 20000
+
+// Gerador pseudoaleatório fixo, para que uma falha seja reproduzível.
+static unsigned int next_random(unsigned int *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 16;
+}
+
+static void set_io_count(Bcp *process, int io_count)
+{
+    process->hot->io_ops[process->hot_index] = io_count;
+}
+
+// Processo que a fila deveria eleger: menor (E/S, PID) entre os enfileirados.
+static int expected_top(const Bcp *processes, const int *queued, int count)
+{
+    int best = -1;
+    for (int i = 0; i < count; i++)
+    {
+        if (!queued[i])
+            continue;
+        if (best == -1 || Process__get_io_count(&processes[i]) < Process__get_io_count(&processes[best]) ||
+            (Process__get_io_count(&processes[i]) == Process__get_io_count(&processes[best]) &&
+             processes[i].pid < processes[best].pid))
+            best = i;
+    }
+    return best == -1 ? -1 : (int)processes[best].table_handle.slot;
+}
+
+// Toda posição guardada na coluna aponta de volta para o slot no heap.
+static int positions_are_consistent(const ReadyQueue *queue, const Bcp *processes, const int *queued, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int position = processes[i].hot->ready_position[processes[i].hot_index];
+        if (!queued[i])
+        {
+            if (position != -1)
+                return 0;
+        }
+        else if (position < 0 || position >= queue->count ||
+                 queue->slots[position] != (int)processes[i].table_handle.slot)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void Test__ready_queue()
+{
+    ProcessTable table;
+    ProcessTable__init(&table);
+    Program program = {.priority_level = 1};
+    Bcp *processes = calloc(QUEUE_PROCESS_COUNT, sizeof(Bcp));
+    int *queued = calloc(QUEUE_PROCESS_COUNT, sizeof(int));
+    for (int i = 0; i < QUEUE_PROCESS_COUNT; i++)
+    {
+        processes[i].pid = i + 1;
+        processes[i].program = &program;
+        ProcessTable__insert(&table, &processes[i]);
+    }
+    ReadyQueue queue;
+    ReadyQueue__init(&queue, &table);
+    CHECK(ReadyQueue__peek(&queue) == -1);
+
+    // Diminuir a chave de um processo do fundo do heap o leva ao topo.
+    for (int i = 0; i < 8; i++)
+    {
+        set_io_count(&processes[i], 10 + i);
+        ReadyQueue__push(&queue, (int)processes[i].table_handle.slot);
+        queued[i] = 1;
+    }
+    CHECK(ReadyQueue__peek(&queue) == (int)processes[0].table_handle.slot);
+    set_io_count(&processes[7], 1);
+    ReadyQueue__update(&queue, (int)processes[7].table_handle.slot);
+    CHECK(ReadyQueue__peek(&queue) == (int)processes[7].table_handle.slot);
+
+    // Empate de E/S: vence o menor PID. Aumentar a chave do topo o afunda.
+    set_io_count(&processes[3], 1);
+    ReadyQueue__update(&queue, (int)processes[3].table_handle.slot);
+    CHECK(ReadyQueue__peek(&queue) == (int)processes[3].table_handle.slot);
+    set_io_count(&processes[3], 100);
+    ReadyQueue__update(&queue, (int)processes[3].table_handle.slot);
+    CHECK(ReadyQueue__peek(&queue) == (int)processes[7].table_handle.slot);
+    CHECK(positions_are_consistent(&queue, processes, queued, QUEUE_PROCESS_COUNT));
+
+    // Atualizar quem não está na fila não faz nada; remover do meio mantém o heap.
+    ReadyQueue__update(&queue, (int)processes[20].table_handle.slot);
+    CHECK(ReadyQueue__remove(&queue, (int)processes[20].table_handle.slot) == 0);
+    CHECK(ReadyQueue__remove(&queue, (int)processes[5].table_handle.slot) == 1);
+    queued[5] = 0;
+    CHECK(queue.count == 7);
+    CHECK(positions_are_consistent(&queue, processes, queued, QUEUE_PROCESS_COUNT));
+
+    // Operações aleatórias conferidas contra uma busca linear.
+    unsigned int state = 7;
+    int mismatches = 0;
+    for (int operation = 0; operation < QUEUE_OPERATIONS; operation++)
+    {
+        int i = (int)(next_random(&state) % QUEUE_PROCESS_COUNT);
+        int slot = (int)processes[i].table_handle.slot;
+        switch (next_random(&state) % 4)
+        {
+        case 0: // Entra ou sai da fila
+            if (queued[i])
+                ReadyQueue__remove(&queue, slot);
+            else
+                ReadyQueue__push(&queue, slot);
+            queued[i] = !queued[i];
+            break;
+        case 1: // Diminui a chave
+            set_io_count(&processes[i], Process__get_io_count(&processes[i]) / 2);
+            ReadyQueue__update(&queue, slot);
+            break;
+        case 2: // Aumenta a chave
+            set_io_count(&processes[i], Process__get_io_count(&processes[i]) + (int)(next_random(&state) % 50));
+            ReadyQueue__update(&queue, slot);
+            break;
+        default: // Elege e remove o topo
+            if (queue.count > 0)
+            {
+                int top = ReadyQueue__peek(&queue);
+                ReadyQueue__remove(&queue, top);
+                for (int j = 0; j < QUEUE_PROCESS_COUNT; j++)
+                    if ((int)processes[j].table_handle.slot == top)
+                        queued[j] = 0;
+            }
+            break;
+        }
+        if (ReadyQueue__peek(&queue) != expected_top(processes, queued, QUEUE_PROCESS_COUNT))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+    CHECK(positions_are_consistent(&queue, processes, queued, QUEUE_PROCESS_COUNT));
+
+    free(queue.slots);
+    ProcessTable__destroy(&table);
+    free(queued);
+    free(processes);
+}
@@ -0,0 +1,120 @@
+#include "ready_queue.h"
+#include <stdlib.h>
+
+// Coluna de um campo quente do slot
+#define HOT_FIELD(queue, slot, field) \
+    (ProcessTable__hot_chunk((queue)->table, (slot))->field[(slot) & PROCESS_HOT_CHUNK_MASK])
+
+// Ordem da fila: menos operações de E/S primeiro; em caso de empate, menor PID.
+static int precedes(const ReadyQueue *queue, int slot_a, int slot_b)
+{
+    int io_a = HOT_FIELD(queue, slot_a, io_ops);
+    int io_b = HOT_FIELD(queue, slot_b, io_ops);
+    if (io_a != io_b)
+        return io_a < io_b;
+    return HOT_FIELD(queue, slot_a, pid) < HOT_FIELD(queue, slot_b, pid);
+}
+
+// Grava o slot na posição do heap e atualiza a coluna de posição.
+static void place(ReadyQueue *queue, int position, int slot)
+{
+    queue->slots[position] = slot;
+    HOT_FIELD(queue, slot, ready_position) = position;
+}
+
+// Sobe o elemento da posição até que o pai o preceda.
+static void sift_up(ReadyQueue *queue, int position)
+{
+    int slot = queue->slots[position];
+    while (position > 0)
+    {
+        int parent = (position - 1) / READY_QUEUE_ARITY;
+        if (!precedes(queue, slot, queue->slots[parent]))
+            break;
+        place(queue, position, queue->slots[parent]);
+        position = parent;
+    }
+    place(queue, position, slot);
+}
+
+// Desce o elemento da posição até que preceda todos os filhos.
+static void sift_down(ReadyQueue *queue, int position)
+{
+    int slot = queue->slots[position];
+    for (;;)
+    {
+        int first_child = position * READY_QUEUE_ARITY + 1;
+        if (first_child >= queue->count)
+            break;
+        int last_child = first_child + READY_QUEUE_ARITY;
+        if (last_child > queue->count)
+            last_child = queue->count;
+        int best_child = first_child;
+        for (int child = first_child + 1; child < last_child; child++)
+        {
+            if (precedes(queue, queue->slots[child], queue->slots[best_child]))
+                best_child = child;
+        }
+        if (!precedes(queue, queue->slots[best_child], slot))
+            break;
+        place(queue, position, queue->slots[best_child]);
+        position = best_child;
+    }
+    place(queue, position, slot);
+}
+
+void ReadyQueue__init(ReadyQueue *queue, const ProcessTable *table)
+{
+    queue->table = table;
+    queue->slots = NULL;
+    queue->count = 0;
+    queue->capacity = 0;
+}
+
+int ReadyQueue__push(ReadyQueue *queue, int slot)
+{
+    if (queue->count == queue->capacity)
+    {
+        int capacity = queue->capacity == 0 ? 64 : queue->capacity * 2;
+        int *grown = realloc(queue->slots, sizeof(int) * capacity);
+        if (grown == NULL)
+            return -1;
+        queue->slots = grown;
+        queue->capacity = capacity;
+    }
+    queue->slots[queue->count] = slot;
+    sift_up(queue, queue->count++);
+    return 0;
+}
+
+int ReadyQueue__peek(const ReadyQueue *queue)
+{
+    return queue->count == 0 ? -1 : queue->slots[0];
+}
+
+int ReadyQueue__remove(ReadyQueue *queue, int slot)
+{
+    int position = HOT_FIELD(queue, slot, ready_position);
+    if (position < 0 || position >= queue->count || queue->slots[position] != slot)
+        return 0;
+    HOT_FIELD(queue, slot, ready_position) = -1;
+
+    // O último elemento ocupa o lugar do removido e é reposicionado.
+    int last_slot = queue->slots[--queue->count];
+    if (position < queue->count)
+    {
+        place(queue, position, last_slot);
+        sift_up(queue, position);
+        sift_down(queue, HOT_FIELD(queue, last_slot, ready_position));
+    }
+    return 1;
+}
+
+void ReadyQueue__update(ReadyQueue *queue, int slot)
+{
+    int position = HOT_FIELD(queue, slot, ready_position);
+    if (position < 0 || position >= queue->count || queue->slots[position] != slot)
+        return;
+    sift_up(queue, position);
+    sift_down(queue, HOT_FIELD(queue, slot, ready_position));
+}
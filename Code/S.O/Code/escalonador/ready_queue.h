@@ -0,0 +1,53 @@
+#ifndef READY_QUEUE_H_GUARD
+#define READY_QUEUE_H_GUARD
+
+#include "../Nucleo/process_table.h"
+
+// -----------------------------------------------------------------------------
+// Fila de prontos: heap de mínimo indexado, com os slots dos processos na tabela
+// de processos. A chave é (operações de E/S, PID), lida das colunas quentes da
+// tabela; a posição de cada processo no heap fica na coluna 'ready_position', o
+// que permite atualizar a chave ou remover um processo qualquer em O(log n).
+//
+// Consultar o próximo processo custa O(1); inserir, remover e atualizar, O(log n).
+// A fila não é thread-safe: quem a usa deve segurar ready_queue_mutex.
+// -----------------------------------------------------------------------------
+
+#define READY_QUEUE_ARITY 4
+
+typedef struct
+{
+    const ProcessTable *table; // Tabela cujas colunas guardam as chaves e as posições
+    int *slots;                // Heap de slots (slots[0] é o próximo a executar)
+    int count;                 // Processos na fila
+    int capacity;              // Capacidade alocada do vetor
+} ReadyQueue;
+
+/**
+ * @brief Inicializa uma fila vazia sobre as colunas de 'table'.
+ */
+void ReadyQueue__init(ReadyQueue *queue, const ProcessTable *table);
+
+/**
+ * @brief Insere o processo do slot. Retorna 0 em caso de sucesso, -1 se faltar memória.
+ */
+int ReadyQueue__push(ReadyQueue *queue, int slot);
+
+/**
+ * @brief Slot do processo com a menor chave, sem removê-lo, ou -1 se a fila estiver vazia.
+ */
+int ReadyQueue__peek(const ReadyQueue *queue);
+
+/**
+ * @brief Remove o processo do slot, esteja onde estiver no heap.
+ * @return 1 se ele estava na fila, 0 caso contrário.
+ */
+int ReadyQueue__remove(ReadyQueue *queue, int slot);
+
+/**
+ * @brief Reposiciona o processo do slot depois que sua chave mudou (não faz nada se
+ * ele não estiver na fila).
+ */
+void ReadyQueue__update(ReadyQueue *queue, int slot);
+
+#endif // READY_QUEUE_H_GUARD
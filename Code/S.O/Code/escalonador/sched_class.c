@@ -0,0 +1,91 @@
+#include "sched_class.h"
+#include "../Process/process.h"
+#include <string.h>
+
+// Classes registradas; a primeira é a padrão.
+static const SchedClass *const sched_classes[] = {
+    &sched_class_least_io,
+    &sched_class_round_robin,
+    &sched_class_mlfq,
+    &sched_class_fair,
+};
+
+#define SCHED_CLASS_COUNT (int)(sizeof(sched_classes) / sizeof(sched_classes[0]))
+
+const SchedClass *SchedClass__find(const char *name)
+{
+    for (int i = 0; i < SCHED_CLASS_COUNT; i++)
+    {
+        if (strcmp(sched_classes[i]->name, name) == 0)
+            return sched_classes[i];
+    }
+    return NULL;
+}
+
+void SchedClass__print_names(FILE *output)
+{
+    for (int i = 0; i < SCHED_CLASS_COUNT; i++)
+        fprintf(output, "%s%s", i == 0 ? "" : "|", sched_classes[i]->name);
+}
+
+// -----------------------------------------------------------------------------
+// Fila FIFO intrusiva
+// -----------------------------------------------------------------------------
+void SchedFifo__init(SchedFifo *fifo)
+{
+    fifo->head = NULL;
+    fifo->tail = NULL;
+}
+
+void SchedFifo__push_back(SchedFifo *fifo, Bcp *process)
+{
+    process->sched.queue_previous = fifo->tail;
+    process->sched.queue_next = NULL;
+    if (fifo->tail != NULL)
+        fifo->tail->sched.queue_next = process;
+    else
+        fifo->head = process;
+    fifo->tail = process;
+}
+
+void SchedFifo__push_front(SchedFifo *fifo, Bcp *process)
+{
+    process->sched.queue_previous = NULL;
+    process->sched.queue_next = fifo->head;
+    if (fifo->head != NULL)
+        fifo->head->sched.queue_previous = process;
+    else
+        fifo->tail = process;
+    fifo->head = process;
+}
+
+void SchedFifo__remove(SchedFifo *fifo, Bcp *process)
+{
+    if (process->sched.queue_previous != NULL)
+        process->sched.queue_previous->sched.queue_next = process->sched.queue_next;
+    else
+        fifo->head = process->sched.queue_next;
+    if (process->sched.queue_next != NULL)
+        process->sched.queue_next->sched.queue_previous = process->sched.queue_previous;
+    else
+        fifo->tail = process->sched.queue_previous;
+    process->sched.queue_previous = NULL;
+    process->sched.queue_next = NULL;
+}
+
+void SchedFifo__append(SchedFifo *target, SchedFifo *source)
+{
+    if (source->head == NULL)
+        return;
+    if (target->tail != NULL)
+    {
+        target->tail->sched.queue_next = source->head;
+        source->head->sched.queue_previous = target->tail;
+    }
+    else
+    {
+        target->head = source->head;
+    }
+    target->tail = source->tail;
+    SchedFifo__init(source);
+}
@@ -0,0 +1,120 @@
+#ifndef SCHED_CLASS_H_GUARD
+#define SCHED_CLASS_H_GUARD
+
+#include "../Nucleo/process_table.h"
+#include "../Ferramentas/rbtree.h"
+#include <stdio.h>
+
+// -----------------------------------------------------------------------------
+// Classes de escalonamento.
+//
+// A política de escalonamento fica atrás de uma interface de ganchos: o
+// escalonador decide QUANDO eleger (trocas de contexto, chegadas, bloqueios) e a
+// classe decide QUEM, mantendo sua própria fila de prontos (uma instância por
+// núcleo da CPU, ver scheduler.h). Todos os ganchos são chamados com
+// ready_queue_mutex travado, então as classes não precisam de travas.
+//
+// Políticas disponíveis (--sched <nome>):
+//   io   - menos operações de E/S, desempate pelo menor PID (padrão, o critério original)
+//   rr   - round-robin: fila FIFO, o processo na CPU mantém a vez até bloquear ou
+//          esgotar o quantum (--quantum)
+//   mlfq - fila multinível com realimentação: desce de nível ao esgotar sua cota de
+//          CPU, sobe ao concluir E/S; todos voltam ao topo periodicamente
+//   cfs  - justa: menor tempo virtual de CPU (ponderado pela prioridade) primeiro,
+//          em uma árvore rubro-negra
+// -----------------------------------------------------------------------------
+
+struct Bcp_t;
+
+// Motivo da inserção na fila de prontos
+typedef enum
+{
+    SCHED_ENQUEUE_NEW,     // Processo recém-carregado na memória
+    SCHED_ENQUEUE_WAKEUP,  // Processo desbloqueado (fim de E/S ou V em semáforo)
+    SCHED_ENQUEUE_RUNNING, // Processo que estava na CPU e volta a concorrer na troca de contexto
+    SCHED_ENQUEUE_EXPIRED  // Processo que saiu da CPU por ter esgotado o quantum (--quantum)
+} SchedEnqueueReason;
+
+// Dados de escalonamento embutidos no BCP (cada classe usa os seus)
+typedef struct SchedEntity_s
+{
+    int is_queued;                 // 1 enquanto o processo está na fila de prontos da classe
+    long long dispatch_time;       // Instante virtual da última eleição (ou contabilização de CPU)
+    struct Bcp_t *queue_previous;  // Vizinhos na fila FIFO (rr, mlfq)
+    struct Bcp_t *queue_next;
+    int queue_level;               // Nível atual (mlfq)
+    long long level_used;          // CPU consumida no nível atual (mlfq)
+    int level_expired;             // 1 se acabou de descer de nível (mlfq)
+    unsigned boost_epoch;          // Última subida geral ao topo vista pelo processo (mlfq)
+    RbNode tree_node;              // Nó na árvore de prontos (cfs)
+    long long vruntime;            // Tempo virtual de CPU ponderado (cfs)
+} SchedEntity;
+
+// Fila FIFO intrusiva de BCPs (pelos campos queue_previous/queue_next)
+typedef struct
+{
+    struct Bcp_t *head;
+    struct Bcp_t *tail;
+} SchedFifo;
+
+typedef struct SchedClass_s
+{
+    const char *name; // Nome usado em --sched
+
+    // Cria o estado da classe (sua fila de prontos). Retorna NULL se faltar memória.
+    void *(*create)(const ProcessTable *table);
+
+    // Insere um processo na fila de prontos. Retorna 0, ou -1 se faltar memória.
+    int (*enqueue)(void *state, struct Bcp_t *process, SchedEnqueueReason reason);
+
+    // Retira um processo da fila. Retorna 1 se ele estava nela, 0 caso contrário.
+    int (*dequeue)(void *state, struct Bcp_t *process);
+
+    // Próximo processo a executar, sem retirá-lo da fila (NULL se vazia).
+    struct Bcp_t *(*pick_next)(void *state);
+
+    // O processo executou 'ran_time' unidades de tempo na CPU desde a última contabilização.
+    // Chamado na troca de contexto, antes de ele voltar a concorrer. Opcional.
+    void (*tick)(void *state, struct Bcp_t *process, long long ran_time);
+
+    // O processo concluiu uma operação de E/S e vai voltar à fila de prontos. Opcional.
+    void (*io_completed)(void *state, struct Bcp_t *process);
+
+    // A contagem de E/S do processo mudou (ver Scheduler__update_process_io_stats). Opcional.
+    void (*io_count_changed)(void *state, struct Bcp_t *process);
+
+    // O processo, já retirado da fila de 'from_state', foi roubado pelo núcleo de 'to_state'
+    // (ver Scheduler__get_next_process_to_run). Opcional.
+    void (*migrate)(void *from_state, void *to_state, struct Bcp_t *process);
+
+    // O núcleo desta fila passou a executar 'process' (NULL = núcleo ocioso). Chamado em
+    // toda troca de contexto, depois de o eleito ser retirado da fila. Opcional.
+    void (*set_running)(void *state, struct Bcp_t *process);
+} SchedClass;
+
+extern const SchedClass sched_class_least_io;
+extern const SchedClass sched_class_round_robin;
+extern const SchedClass sched_class_mlfq;
+extern const SchedClass sched_class_fair;
+
+/**
+ * @brief Busca uma classe pelo nome. Retorna NULL se não existir.
+ */
+const SchedClass *SchedClass__find(const char *name);
+
+/**
+ * @brief Imprime os nomes das classes disponíveis, separados por '|'.
+ */
+void SchedClass__print_names(FILE *output);
+
+/* ---------- Fila FIFO intrusiva (usada por rr e mlfq) ---------- */
+
+void SchedFifo__init(SchedFifo *fifo);
+void SchedFifo__push_back(SchedFifo *fifo, struct Bcp_t *process);
+void SchedFifo__push_front(SchedFifo *fifo, struct Bcp_t *process);
+void SchedFifo__remove(SchedFifo *fifo, struct Bcp_t *process);
+
+// Move todos os processos de 'source' para o fim de 'target' em O(1).
+void SchedFifo__append(SchedFifo *target, SchedFifo *source);
+
+#endif // SCHED_CLASS_H_GUARD
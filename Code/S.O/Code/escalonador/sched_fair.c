@@ -0,0 +1,161 @@
+#include "sched_class.h"
+#include "../Process/process.h"
+#include "../Clock/clock.h"
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Política "cfs": escalonamento justo por tempo virtual de CPU.
+//
+// Cada processo acumula vruntime = CPU usada * peso padrão / seu peso, e é eleito
+// o de menor vruntime (desempate pelo menor PID), guardado em uma árvore
+// rubro-negra com o mínimo em cache. O peso vem da prioridade: a prioridade 3
+// tem o peso padrão e cada nível vale ~25% de CPU a mais (menor número) ou a
+// menos (maior número), como o nice do Linux.
+//
+// min_vruntime acompanha o menor vruntime entre o processo em execução e a fila,
+// e nunca diminui: processos novos começam nele, e processos que acordam recebem
+// no máximo um crédito de CFS_WAKEUP_CREDIT sobre ele, para que um longo bloqueio
+// não vire um longo monopólio da CPU. Sem contar quem está na CPU, o piso pararia
+// enquanto um processo executa sozinho (ou à frente dos demais), e quem chegasse
+// seria posicionado muito atrás dele.
+//
+// Cada núcleo tem seu próprio min_vruntime: um processo roubado por outro núcleo
+// leva a sua distância ao min_vruntime de origem, não o valor absoluto.
+// -----------------------------------------------------------------------------
+
+#define CFS_DEFAULT_WEIGHT 1024
+#define CFS_WAKEUP_CREDIT 1000LL
+
+// Pesos das prioridades 1 a 10 (fora da faixa, usa o extremo mais próximo)
+static const int priority_weights[] = {1586, 1277, 1024, 820, 655, 526, 423, 335, 272, 215};
+
+#define PRIORITY_LEVELS (int)(sizeof(priority_weights) / sizeof(priority_weights[0]))
+
+typedef struct
+{
+    RbTree tree;            // Processos prontos, por (vruntime, PID)
+    long long min_vruntime; // Piso de vruntime para quem chega à fila
+    Bcp *running;           // Processo em execução no núcleo (NULL = ocioso)
+} FairState;
+
+static int priority_weight(int priority)
+{
+    if (priority < 1)
+        priority = 1;
+    if (priority > PRIORITY_LEVELS)
+        priority = PRIORITY_LEVELS;
+    return priority_weights[priority - 1];
+}
+
+static int compare_vruntime(const RbNode *a, const RbNode *b)
+{
+    const Bcp *process_a = RBTREE_ENTRY(a, Bcp, sched.tree_node);
+    const Bcp *process_b = RBTREE_ENTRY(b, Bcp, sched.tree_node);
+    if (process_a->sched.vruntime != process_b->sched.vruntime)
+        return process_a->sched.vruntime < process_b->sched.vruntime ? -1 : 1;
+    return process_a->pid < process_b->pid ? -1 : (process_a->pid > process_b->pid);
+}
+
+// CPU usada convertida em vruntime, segundo a prioridade (lida da coluna quente do processo)
+static long long weighted_runtime(const Bcp *process, long long ran_time)
+{
+    return ran_time * CFS_DEFAULT_WEIGHT / priority_weight(Process__get_priority(process));
+}
+
+// Avança min_vruntime até o menor vruntime entre o processo em execução (incluindo a
+// CPU usada desde a última contabilização) e o primeiro da fila
+static void update_min_vruntime(FairState *fair)
+{
+    int has_candidate = 0;
+    long long vruntime = 0;
+    const Bcp *running = fair->running;
+    if (running != NULL && Process__get_state(running) == PROCESS_STATE_RUNNING)
+    {
+        vruntime = running->sched.vruntime + weighted_runtime(running, Clock__get_time() - running->sched.dispatch_time);
+        has_candidate = 1;
+    }
+    RbNode *first = rbtree_first(&fair->tree);
+    if (first != NULL)
+    {
+        long long leftmost_vruntime = RBTREE_ENTRY(first, Bcp, sched.tree_node)->sched.vruntime;
+        if (!has_candidate || leftmost_vruntime < vruntime)
+            vruntime = leftmost_vruntime;
+        has_candidate = 1;
+    }
+    if (has_candidate && vruntime > fair->min_vruntime)
+        fair->min_vruntime = vruntime;
+}
+
+static void *fair_create(const ProcessTable *table)
+{
+    (void)table;
+    FairState *fair = malloc(sizeof(FairState));
+    if (fair == NULL)
+        return NULL;
+    rbtree_init(&fair->tree, compare_vruntime);
+    fair->min_vruntime = 0;
+    fair->running = NULL;
+    return fair;
+}
+
+static int fair_enqueue(void *state, Bcp *process, SchedEnqueueReason reason)
+{
+    FairState *fair = (FairState *)state;
+    update_min_vruntime(fair);
+    if (reason == SCHED_ENQUEUE_NEW)
+    {
+        process->sched.vruntime = fair->min_vruntime;
+    }
+    else if (reason == SCHED_ENQUEUE_WAKEUP && process->sched.vruntime < fair->min_vruntime - CFS_WAKEUP_CREDIT)
+    {
+        process->sched.vruntime = fair->min_vruntime - CFS_WAKEUP_CREDIT;
+    }
+    rbtree_insert(&fair->tree, &process->sched.tree_node);
+    process->sched.is_queued = 1;
+    return 0;
+}
+
+static int fair_dequeue(void *state, Bcp *process)
+{
+    FairState *fair = (FairState *)state;
+    if (!process->sched.is_queued)
+        return 0;
+    rbtree_remove(&fair->tree, &process->sched.tree_node);
+    process->sched.is_queued = 0;
+    return 1;
+}
+
+static Bcp *fair_pick_next(void *state)
+{
+    FairState *fair = (FairState *)state;
+    update_min_vruntime(fair);
+    RbNode *first = rbtree_first(&fair->tree);
+    return first == NULL ? NULL : RBTREE_ENTRY(first, Bcp, sched.tree_node);
+}
+
+static void fair_tick(void *state, Bcp *process, long long ran_time)
+{
+    (void)state;
+    process->sched.vruntime += weighted_runtime(process, ran_time);
+}
+
+static void fair_migrate(void *from_state, void *to_state, Bcp *process)
+{
+    process->sched.vruntime += ((FairState *)to_state)->min_vruntime - ((FairState *)from_state)->min_vruntime;
+}
+
+static void fair_set_running(void *state, Bcp *process)
+{
+    ((FairState *)state)->running = process;
+}
+
+const SchedClass sched_class_fair = {
+    .name = "cfs",
+    .create = fair_create,
+    .enqueue = fair_enqueue,
+    .dequeue = fair_dequeue,
+    .pick_next = fair_pick_next,
+    .tick = fair_tick,
+    .migrate = fair_migrate,
+    .set_running = fair_set_running,
+};
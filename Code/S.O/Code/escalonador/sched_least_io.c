@@ -0,0 +1,51 @@
+#include "sched_class.h"
+#include "ready_queue.h"
+#include "../Process/process.h"
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Política "io": menos operações de E/S primeiro, desempate pelo menor PID.
+// A fila é o heap indexado de ready_queue.h, sobre as colunas da tabela.
+// -----------------------------------------------------------------------------
+
+static void *least_io_create(const ProcessTable *table)
+{
+    ReadyQueue *queue = malloc(sizeof(ReadyQueue));
+    if (queue != NULL)
+        ReadyQueue__init(queue, table);
+    return queue;
+}
+
+static int least_io_enqueue(void *state, Bcp *process, SchedEnqueueReason reason)
+{
+    (void)reason; // O critério não depende de como o processo chegou à fila
+    return ReadyQueue__push((ReadyQueue *)state, (int)process->table_handle.slot);
+}
+
+static int least_io_dequeue(void *state, Bcp *process)
+{
+    return ReadyQueue__remove((ReadyQueue *)state, (int)process->table_handle.slot);
+}
+
+static Bcp *least_io_pick_next(void *state)
+{
+    ReadyQueue *queue = (ReadyQueue *)state;
+    int slot = ReadyQueue__peek(queue);
+    if (slot == -1)
+        return NULL;
+    return ProcessTable__hot_chunk(queue->table, slot)->process[slot & PROCESS_HOT_CHUNK_MASK];
+}
+
+static void least_io_count_changed(void *state, Bcp *process)
+{
+    ReadyQueue__update((ReadyQueue *)state, (int)process->table_handle.slot);
+}
+
+const SchedClass sched_class_least_io = {
+    .name = "io",
+    .create = least_io_create,
+    .enqueue = least_io_enqueue,
+    .dequeue = least_io_dequeue,
+    .pick_next = least_io_pick_next,
+    .io_count_changed = least_io_count_changed,
+};
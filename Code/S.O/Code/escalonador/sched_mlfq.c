@@ -0,0 +1,145 @@
+#include "sched_class.h"
+#include "../Process/process.h"
+#include "../Clock/clock.h"
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Política "mlfq": fila multinível com realimentação.
+//
+// Cada nível é uma fila FIFO, e o primeiro nível não vazio é o atendido. Todo
+// processo começa no nível 0; ao acumular a cota de CPU do nível ele desce um
+// nível, e ao concluir uma operação de E/S sobe um (e recomeça a cota). A cada
+// MLFQ_BOOST_PERIOD unidades de tempo virtual todos voltam ao nível 0, para que
+// processos de CPU não fiquem sem atendimento: as filas são concatenadas em O(1)
+// e o nível de cada processo é corrigido depois, quando ele é visto de novo
+// (pela época da última subida geral). Cada núcleo conta suas próprias épocas.
+// -----------------------------------------------------------------------------
+
+#define MLFQ_LEVELS 3
+#define MLFQ_BOOST_PERIOD 100000LL
+
+// Cota de CPU de cada nível (o último não tem cota)
+static const long long level_allotment[MLFQ_LEVELS] = {2000, 10000, 0};
+
+typedef struct
+{
+    SchedFifo levels[MLFQ_LEVELS]; // Filas de prontos, da maior prioridade para a menor
+    unsigned boost_epoch;          // Subidas gerais já realizadas
+    long long next_boost_time;     // Instante virtual da próxima subida geral
+} MlfqState;
+
+// Atualiza o nível de um processo que não viu a última subida geral.
+static void catch_up_boost(const MlfqState *mlfq, Bcp *process)
+{
+    if (process->sched.boost_epoch == mlfq->boost_epoch)
+        return;
+    process->sched.boost_epoch = mlfq->boost_epoch;
+    process->sched.queue_level = 0;
+    process->sched.level_used = 0;
+    process->sched.level_expired = 0;
+}
+
+// Leva todos os processos ao nível 0, se já for a hora.
+static void boost_if_due(MlfqState *mlfq)
+{
+    long long now = Clock__get_time();
+    if (now < mlfq->next_boost_time)
+        return;
+    for (int level = 1; level < MLFQ_LEVELS; level++)
+        SchedFifo__append(&mlfq->levels[0], &mlfq->levels[level]);
+    mlfq->boost_epoch++;
+    mlfq->next_boost_time = now + MLFQ_BOOST_PERIOD;
+}
+
+static void *mlfq_create(const ProcessTable *table)
+{
+    (void)table;
+    MlfqState *mlfq = malloc(sizeof(MlfqState));
+    if (mlfq == NULL)
+        return NULL;
+    for (int level = 0; level < MLFQ_LEVELS; level++)
+        SchedFifo__init(&mlfq->levels[level]);
+    mlfq->boost_epoch = 0;
+    mlfq->next_boost_time = MLFQ_BOOST_PERIOD;
+    return mlfq;
+}
+
+static int mlfq_enqueue(void *state, Bcp *process, SchedEnqueueReason reason)
+{
+    MlfqState *mlfq = (MlfqState *)state;
+    catch_up_boost(mlfq, process);
+    SchedFifo *level = &mlfq->levels[process->sched.queue_level];
+    // Quem estava na CPU mantém a vez no seu nível, a menos que tenha acabado de descer
+    // ou esgotado o quantum.
+    if (reason == SCHED_ENQUEUE_RUNNING && !process->sched.level_expired)
+        SchedFifo__push_front(level, process);
+    else
+        SchedFifo__push_back(level, process);
+    process->sched.level_expired = 0;
+    process->sched.is_queued = 1;
+    return 0;
+}
+
+static int mlfq_dequeue(void *state, Bcp *process)
+{
+    MlfqState *mlfq = (MlfqState *)state;
+    if (!process->sched.is_queued)
+        return 0;
+    // Um processo na fila que não viu a última subida geral já está na fila do nível 0.
+    catch_up_boost(mlfq, process);
+    SchedFifo__remove(&mlfq->levels[process->sched.queue_level], process);
+    process->sched.is_queued = 0;
+    return 1;
+}
+
+static Bcp *mlfq_pick_next(void *state)
+{
+    MlfqState *mlfq = (MlfqState *)state;
+    boost_if_due(mlfq);
+    for (int level = 0; level < MLFQ_LEVELS; level++)
+    {
+        if (mlfq->levels[level].head != NULL)
+            return mlfq->levels[level].head;
+    }
+    return NULL;
+}
+
+static void mlfq_tick(void *state, Bcp *process, long long ran_time)
+{
+    catch_up_boost((MlfqState *)state, process);
+    int level = process->sched.queue_level;
+    process->sched.level_used += ran_time;
+    if (level < MLFQ_LEVELS - 1 && process->sched.level_used >= level_allotment[level])
+    {
+        process->sched.queue_level = level + 1;
+        process->sched.level_used = 0;
+        process->sched.level_expired = 1;
+    }
+}
+
+static void mlfq_io_completed(void *state, Bcp *process)
+{
+    catch_up_boost((MlfqState *)state, process);
+    if (process->sched.queue_level > 0)
+        process->sched.queue_level--;
+    process->sched.level_used = 0;
+}
+
+// A retirada da fila de origem já aplicou a última subida geral de lá; o processo
+// passa a acompanhar as épocas do núcleo de destino.
+static void mlfq_migrate(void *from_state, void *to_state, Bcp *process)
+{
+    (void)from_state;
+    process->sched.boost_epoch = ((MlfqState *)to_state)->boost_epoch;
+}
+
+const SchedClass sched_class_mlfq = {
+    .name = "mlfq",
+    .create = mlfq_create,
+    .enqueue = mlfq_enqueue,
+    .dequeue = mlfq_dequeue,
+    .pick_next = mlfq_pick_next,
+    .tick = mlfq_tick,
+    .io_completed = mlfq_io_completed,
+    .migrate = mlfq_migrate,
+};
@@ -0,0 +1,51 @@
+#include "sched_class.h"
+#include "../Process/process.h"
+#include <stdlib.h>
+
+// -----------------------------------------------------------------------------
+// Política "rr": round-robin. Processos entram no fim da fila e são eleitos pela
+// ordem de chegada; o processo que estava na CPU volta à frente, mantendo a vez
+// até bloquear, terminar ou esgotar o quantum (a chegada de outro processo não o
+// preempta). Ao esgotar o quantum, vai para o fim da fila.
+// -----------------------------------------------------------------------------
+
+static void *round_robin_create(const ProcessTable *table)
+{
+    (void)table;
+    SchedFifo *fifo = malloc(sizeof(SchedFifo));
+    if (fifo != NULL)
+        SchedFifo__init(fifo);
+    return fifo;
+}
+
+static int round_robin_enqueue(void *state, Bcp *process, SchedEnqueueReason reason)
+{
+    if (reason == SCHED_ENQUEUE_RUNNING)
+        SchedFifo__push_front((SchedFifo *)state, process);
+    else
+        SchedFifo__push_back((SchedFifo *)state, process);
+    process->sched.is_queued = 1;
+    return 0;
+}
+
+static int round_robin_dequeue(void *state, Bcp *process)
+{
+    if (!process->sched.is_queued)
+        return 0;
+    SchedFifo__remove((SchedFifo *)state, process);
+    process->sched.is_queued = 0;
+    return 1;
+}
+
+static Bcp *round_robin_pick_next(void *state)
+{
+    return ((SchedFifo *)state)->head;
+}
+
+const SchedClass sched_class_round_robin = {
+    .name = "rr",
+    .create = round_robin_create,
+    .enqueue = round_robin_enqueue,
+    .dequeue = round_robin_dequeue,
+    .pick_next = round_robin_pick_next,
+};
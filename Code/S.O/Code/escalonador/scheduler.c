@@ -1,12 +1,15 @@
 #include "scheduler.h"
 #include "../CPU/cpu.h"
+#include "../Clock/clock.h"
+#include "../Nucleo/config.h"
 #include <stdlib.h>
-#include <limits.h>
 #include <stdio.h>
-#include <string.h>                 // Para strdup
-#include "../Ferramentas/compare.h" // Para compare_strings_func
+#include <time.h>                   // Para medir o tempo das trocas de contexto
 
-#define MAX_LOG_MESSAGES 15 // Define o tamanho máximo do log da UI
+
+// Parâmetros do hash FNV-1a de 64 bits usado no digest do escalonamento
+#define FNV_OFFSET_BASIS 1469598103934665603ULL
+#define FNV_PRIME 1099511628211ULL
 
 // Cria e inicializa uma instância do escalonador
 Scheduler *Scheduler__create()
@@ -16,11 +19,79 @@ Scheduler *Scheduler__create()
     {
         return NULL;
     }
-    new_scheduler_instance->ready_queue = create_list(); // Fila de processos prontos
+    // Classe de escalonamento escolhida na configuração, com uma fila de prontos por núcleo
+    new_scheduler_instance->sched_class = SchedClass__find(kernel_config.sched_policy);
+    if (new_scheduler_instance->sched_class == NULL)
+        new_scheduler_instance->sched_class = &sched_class_least_io;
+    new_scheduler_instance->core_count = kernel_config.cpu_core_count;
+    new_scheduler_instance->run_queues = calloc((size_t)new_scheduler_instance->core_count, sizeof(SchedRunQueue));
+    if (new_scheduler_instance->run_queues == NULL)
+    {
+        free(new_scheduler_instance);
+        return NULL;
+    }
+    for (int core = 0; core < new_scheduler_instance->core_count; core++)
+    {
+        SchedRunQueue *run_queue = &new_scheduler_instance->run_queues[core];
+        run_queue->class_state = new_scheduler_instance->sched_class->create(&kernel_instance->process_table);
+        if (run_queue->class_state == NULL)
+        {
+            for (int created = 0; created < core; created++)
+                free(new_scheduler_instance->run_queues[created].class_state);
+            free(new_scheduler_instance->run_queues);
+            free(new_scheduler_instance);
+            return NULL;
+        }
+    }
+    new_scheduler_instance->ready_count = 0;
+    new_scheduler_instance->steal_count = 0;
+    new_scheduler_instance->context_switch_count = 0;
+    new_scheduler_instance->schedule_digest = FNV_OFFSET_BASIS;
+    new_scheduler_instance->context_switch_ns = 0;
     pthread_mutex_init(&new_scheduler_instance->ready_queue_mutex, NULL); // Inicializa o mutex
     return new_scheduler_instance;
 }
 
+// Acumula um valor no hash FNV-1a, byte a byte
+static unsigned long long fnv1a_add(unsigned long long hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Registra uma eleição (instante virtual e PID eleito, 0 = núcleo ocioso) no digest do escalonamento.
+// O núcleo só entra no digest com mais de um núcleo, para que o digest de um único núcleo
+// continue comparável ao de versões anteriores.
+static void record_election(Scheduler *scheduler, int core, Bcp *elected)
+{
+    long long election_time = Clock__get_time();
+    int elected_pid = elected ? elected->pid : 0;
+    scheduler->schedule_digest = fnv1a_add(scheduler->schedule_digest, &election_time, sizeof(election_time));
+    scheduler->schedule_digest = fnv1a_add(scheduler->schedule_digest, &elected_pid, sizeof(elected_pid));
+    if (scheduler->core_count > 1)
+        scheduler->schedule_digest = fnv1a_add(scheduler->schedule_digest, &core, sizeof(core));
+}
+
+// Instante real atual, em nanossegundos
+static long long monotonic_now_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// Soma ao total do escalonador o tempo real gasto em uma troca de contexto
+static void account_switch_time(long long switch_start_ns)
+{
+    __atomic_fetch_add(&kernel_instance->scheduler->context_switch_ns, monotonic_now_ns() - switch_start_ns,
+                       __ATOMIC_RELAXED);
+}
+
 // Atualiza estatísticas de I/O do processo (read/write)
 void Scheduler__update_process_io_stats(Bcp *target_process_bcp, int was_read_operation)
 {
@@ -37,103 +108,240 @@ void Scheduler__update_process_io_stats(Bcp *target_process_bcp, int was_read_op
     {
         target_process_bcp->total_write_ops++;
     }
+    // A soma usada na eleição pode ser a chave do processo na fila de prontos: a classe
+    // é avisada sob a mesma trava que protege as comparações da fila.
+    Scheduler *scheduler = kernel_instance->scheduler;
+    pthread_mutex_lock(&scheduler->ready_queue_mutex);
+    target_process_bcp->hot->io_ops[target_process_bcp->hot_index]++;
+    if (scheduler->sched_class->io_count_changed != NULL)
+        scheduler->sched_class->io_count_changed(scheduler->run_queues[target_process_bcp->cpu_core].class_state,
+                                                 target_process_bcp);
+    pthread_mutex_unlock(&scheduler->ready_queue_mutex);
 }
 
-// Seleciona o próximo processo a ser executado, baseado no menor número de operações de I/O
-Bcp *Scheduler__get_next_process_to_run()
+// Núcleo com menos processos (prontos ou em execução), desempate pelo menor índice
+static int least_loaded_core(const Scheduler *scheduler)
 {
-    // A trava já deve ter sido adquirida por quem chamou esta função (Scheduler__perform_context_switch)
-    if (kernel_instance == NULL || kernel_instance->scheduler->ready_queue->size == 0)
+    int best_core = 0;
+    int best_load = scheduler->run_queues[0].ready_count + scheduler->run_queues[0].is_running;
+    for (int core = 1; core < scheduler->core_count; core++)
     {
-        return NULL; // Fila de prontos vazia
+        int load = scheduler->run_queues[core].ready_count + scheduler->run_queues[core].is_running;
+        if (load < best_load)
+        {
+            best_core = core;
+            best_load = load;
+        }
     }
+    return best_core;
+}
 
-    Node *current_node = kernel_instance->scheduler->ready_queue->head;
-    Bcp *chosen_process = NULL;
-    int lowest_io_count = INT_MAX;
-
-    // Percorre a fila de prontos para encontrar o processo com menos I/O
-    while (current_node != NULL)
+// Núcleo com mais processos prontos, desempate pelo menor índice (-1 se todas as filas estão vazias)
+static int busiest_core(const Scheduler *scheduler)
+{
+    int best_core = -1;
+    int best_count = 0;
+    for (int core = 0; core < scheduler->core_count; core++)
     {
-        Bcp *p = (Bcp *)current_node->data;
-        int current_io = p->total_read_ops + p->total_write_ops;
-
-        if (current_io < lowest_io_count)
-        {
-            lowest_io_count = current_io;
-            chosen_process = p;
-        }
-        else if (current_io == lowest_io_count)
+        if (scheduler->run_queues[core].ready_count > best_count)
         {
-            // Critério de desempate: menor PID
-            if (chosen_process == NULL || (p->pid < chosen_process->pid))
-            {
-                chosen_process = p;
-            }
+            best_core = core;
+            best_count = scheduler->run_queues[core].ready_count;
         }
-        current_node = current_node->next;
     }
+    return best_core;
+}
+
+void Scheduler__add_ready_process(Bcp *ready_process, SchedEnqueueReason reason)
+{
+    Scheduler *scheduler = kernel_instance->scheduler;
+    if (reason == SCHED_ENQUEUE_NEW)
+        ready_process->cpu_core = least_loaded_core(scheduler);
+    SchedRunQueue *run_queue = &scheduler->run_queues[ready_process->cpu_core];
+    if (scheduler->sched_class->enqueue(run_queue->class_state, ready_process, reason) != 0)
+    {
+        fprintf(stderr, "Erro: memoria insuficiente para a fila de prontos\n");
+        exit(1);
+    }
+    run_queue->ready_count++;
+    scheduler->ready_count++;
+}
 
-    return chosen_process;
+void Scheduler__io_completed(Bcp *process)
+{
+    Scheduler *scheduler = kernel_instance->scheduler;
+    if (scheduler->sched_class->io_completed != NULL)
+        scheduler->sched_class->io_completed(scheduler->run_queues[process->cpu_core].class_state, process);
 }
 
-// Realiza o escalonamento e troca de contexto entre processos
-void Scheduler__perform_context_switch()
+// Seleciona o próximo processo a ser executado no núcleo, segundo a classe de escalonamento
+Bcp *Scheduler__get_next_process_to_run(int core, int *source_core)
+{
+    // A trava já deve ter sido adquirida por quem chamou esta função (Scheduler__perform_context_switch)
+    *source_core = core;
+    if (kernel_instance == NULL)
+        return NULL;
+    Scheduler *scheduler = kernel_instance->scheduler;
+    Bcp *next_process = scheduler->sched_class->pick_next(scheduler->run_queues[core].class_state);
+    if (next_process != NULL || scheduler->ready_count == 0)
+        return next_process;
+
+    // Fila local vazia: rouba o próximo processo do núcleo com mais processos prontos.
+    int victim_core = busiest_core(scheduler);
+    if (victim_core < 0)
+        return NULL;
+    *source_core = victim_core;
+    return scheduler->sched_class->pick_next(scheduler->run_queues[victim_core].class_state);
+}
+
+// Registra a eleição de um núcleo no log do kernel (o log tem seu próprio mutex)
+static void log_election(const Scheduler *scheduler, int core, int source_core, Bcp *elected)
+{
+    if (scheduler->core_count == 1)
+    {
+        if (elected != NULL)
+            Kernel__log_message("SCHED: PID %d eleito (I/O: %d).", elected->pid, Process__get_io_count(elected));
+        else
+            Kernel__log_message("SCHED: Fila de prontos vazia. CPU ociosa.");
+    }
+    else if (elected == NULL)
+    {
+        Kernel__log_message("SCHED: CPU %d: filas de prontos vazias. Nucleo ocioso.", core);
+    }
+    else if (source_core != core)
+    {
+        Kernel__log_message("SCHED: CPU %d: PID %d roubado da CPU %d (I/O: %d).", core, elected->pid, source_core,
+                            Process__get_io_count(elected));
+    }
+    else
+    {
+        Kernel__log_message("SCHED: CPU %d: PID %d eleito (I/O: %d).", core, elected->pid,
+                            Process__get_io_count(elected));
+    }
+}
+
+// Realiza o escalonamento e troca de contexto em um núcleo da CPU
+void Scheduler__perform_context_switch(int core)
 {
     if (kernel_instance == NULL)
         return;
+    long long switch_start_ns = monotonic_now_ns();
 
-    // Trava o mutex para garantir acesso atômico à fila de prontos
+    // Trava a CPU para que nenhuma instrução execute durante a troca, e então o mutex
+    // para garantir acesso atômico às filas de prontos
+    CPU__lock();
     pthread_mutex_lock(&kernel_instance->scheduler->ready_queue_mutex);
 
-    Bcp *previously_running_bcp = kernel_instance->running_process;
-    Bcp *next_bcp_to_run = Scheduler__get_next_process_to_run();
+    Bcp *previously_running_bcp = kernel_instance->running_process[core];
+    int previous_still_running = (previously_running_bcp != NULL &&
+                                  Process__get_state(previously_running_bcp) == PROCESS_STATE_RUNNING);
 
-    char log_buffer[256];
-
-    // Se o processo que estava rodando não foi bloqueado ou terminado, ele volta para a fila de prontos.
-    if (previously_running_bcp != NULL && previously_running_bcp->current_execution_state == PROCESS_STATE_RUNNING)
+    // Um processo aguardando o resultado de uma operação P/V não é preemptado:
+    // o próprio handler dessa operação chamará o escalonador em seguida.
+    if (previous_still_running && previously_running_bcp->pending_syscall)
     {
-        previously_running_bcp->current_execution_state = PROCESS_STATE_READY;
-        add_to_list(kernel_instance->scheduler->ready_queue, previously_running_bcp);
+        pthread_mutex_unlock(&kernel_instance->scheduler->ready_queue_mutex);
+        CPU__unlock();
+        account_switch_time(switch_start_ns);
+        return;
     }
 
-    // Prepara a mensagem de log
-    if (next_bcp_to_run != NULL)
+    // Um processo cujo quantum acabou vai para o fim da fila e, mesmo que seja reeleito,
+    // recomeça a CPU com uma fatia nova (o restante do 'exec' fica guardado no BCP).
+    int quantum_expired = previous_still_running && previously_running_bcp->quantum_expired;
+    if (previously_running_bcp != NULL)
+        previously_running_bcp->quantum_expired = 0;
+
+    // A classe contabiliza a CPU usada pelo processo que sai (ou volta a concorrer).
+    Scheduler *scheduler = kernel_instance->scheduler;
+    SchedRunQueue *run_queue = &scheduler->run_queues[core];
+    long long now = Clock__get_time();
+    if (previously_running_bcp != NULL && scheduler->sched_class->tick != NULL)
     {
-        int io_count = next_bcp_to_run->total_read_ops + next_bcp_to_run->total_write_ops;
-        sprintf(log_buffer, "SCHED: PID %d eleito (I/O: %d).", next_bcp_to_run->pid, io_count);
+        scheduler->sched_class->tick(run_queue->class_state, previously_running_bcp,
+                                     now - previously_running_bcp->sched.dispatch_time);
+        previously_running_bcp->sched.dispatch_time = now;
     }
-    else
+
+    // Se o processo que estava rodando não foi bloqueado ou terminado, ele volta para a fila
+    // de prontos do núcleo antes da eleição, concorrendo com os demais.
+    if (previous_still_running)
     {
-        sprintf(log_buffer, "SCHED: Fila de prontos vazia. CPU ociosa.");
+        Process__set_state(previously_running_bcp, PROCESS_STATE_READY);
+        Scheduler__add_ready_process(previously_running_bcp,
+                                     quantum_expired ? SCHED_ENQUEUE_EXPIRED : SCHED_ENQUEUE_RUNNING);
     }
 
-    // Adiciona a mensagem ao log de forma segura (o log tem seu próprio mutex)
-    pthread_mutex_lock(&kernel_instance->scheduler_log_mutex);
-    // Mantém o log com um tamanho gerenciável
-    while (kernel_instance->scheduler_log->size >= MAX_LOG_MESSAGES)
+    int source_core;
+    Bcp *next_bcp_to_run = Scheduler__get_next_process_to_run(core, &source_core);
+
+    // Um processo preemptado no meio de uma rajada de 'exec's fundidos retoma do 'exec'
+    // em que estaria se cada um tivesse sido executado separadamente.
+    int previous_leaves_cpu = previous_still_running && (next_bcp_to_run != previously_running_bcp || quantum_expired);
+    if (previous_leaves_cpu)
     {
-        Node *old_node = kernel_instance->scheduler_log->head;
-        void *data_to_free = old_node->data;
-        remove_from_list(kernel_instance->scheduler_log, data_to_free, compare_strings_func);
-        free(data_to_free); // Libera a string antiga
+        Process__interrupt_cpu_burst(previously_running_bcp, quantum_expired);
     }
-    add_to_list(kernel_instance->scheduler_log, strdup(log_buffer));
-    pthread_mutex_unlock(&kernel_instance->scheduler_log_mutex);
+
+    log_election(scheduler, core, source_core, next_bcp_to_run);
 
     // Se um novo processo foi escolhido, remove-o da fila de prontos e o define como 'running'.
+    // Um processo roubado passa a pertencer ao núcleo que o elegeu.
     if (next_bcp_to_run != NULL)
     {
-        remove_from_list(kernel_instance->scheduler->ready_queue, next_bcp_to_run, compare_pid);
-        next_bcp_to_run->current_execution_state = PROCESS_STATE_RUNNING;
+        SchedRunQueue *source_queue = &scheduler->run_queues[source_core];
+        scheduler->sched_class->dequeue(source_queue->class_state, next_bcp_to_run);
+        source_queue->ready_count--;
+        scheduler->ready_count--;
+        if (source_core != core)
+        {
+            if (scheduler->sched_class->migrate != NULL)
+                scheduler->sched_class->migrate(source_queue->class_state, run_queue->class_state, next_bcp_to_run);
+            next_bcp_to_run->cpu_core = core;
+            scheduler->steal_count++;
+        }
+        Process__set_state(next_bcp_to_run, PROCESS_STATE_RUNNING);
+        next_bcp_to_run->sched.dispatch_time = now;
     }
 
-    // Atualiza o processo em execução no kernel e instrui a CPU a executá-lo.
-    kernel_instance->running_process = next_bcp_to_run;
+    // Atualiza o processo em execução no núcleo.
+    if (scheduler->sched_class->set_running != NULL)
+        scheduler->sched_class->set_running(run_queue->class_state, next_bcp_to_run);
+    kernel_instance->running_process[core] = next_bcp_to_run;
+    run_queue->is_running = (next_bcp_to_run != NULL);
+    scheduler->context_switch_count++;
+    record_election(scheduler, core, next_bcp_to_run);
 
-    // Destrava o mutex após todas as operações na fila de prontos
+    // Destrava o mutex após todas as operações nas filas de prontos
     pthread_mutex_unlock(&kernel_instance->scheduler->ready_queue_mutex);
 
-    CPU__run_process(next_bcp_to_run);
-}
\ No newline at end of file
+    // Instrui o núcleo a executar o processo eleito, que começa uma fatia de tempo nova. Se o
+    // processo que já estava rodando foi reeleito, o núcleo continua de onde estava (ex: no
+    // meio de um 'exec').
+    if (!previous_still_running || previous_leaves_cpu)
+    {
+        if (next_bcp_to_run != NULL)
+            next_bcp_to_run->slice_end_time = now + kernel_config.quantum;
+        CPU__run_process(core, next_bcp_to_run);
+    }
+    CPU__unlock();
+    account_switch_time(switch_start_ns);
+}
+
+void Scheduler__wake_idle_cores()
+{
+    if (kernel_instance == NULL)
+        return;
+    Scheduler *scheduler = kernel_instance->scheduler;
+    for (int core = 0; core < scheduler->core_count; core++)
+    {
+        CPU__lock();
+        pthread_mutex_lock(&scheduler->ready_queue_mutex);
+        int must_elect = (kernel_instance->running_process[core] == NULL && scheduler->ready_count > 0);
+        pthread_mutex_unlock(&scheduler->ready_queue_mutex);
+        CPU__unlock();
+
+        if (must_elect)
+            Scheduler__perform_context_switch(core);
+    }
+}
@@ -2,20 +2,46 @@
 #define SCHEDULER_H_GUARD
 
 #include "../Nucleo/kernel.h"
+#include "sched_class.h"
 #include "../Ferramentas/list.h"
 #include "../Ferramentas/compare.h"
 #include <pthread.h> // Adicionado para pthread_mutex_t
 
+/*
+ * Fila de prontos de um núcleo da CPU (protegida por ready_queue_mutex).
+ */
+typedef struct
+{
+    void *class_state; // Estado da classe, com os processos prontos deste núcleo
+    int ready_count;   // Processos na fila
+    int is_running;    // 1 se o núcleo tem um processo em execução (usado no balanceamento)
+} SchedRunQueue;
+
 /*
  * Estrutura principal do Escalonador.
- * Mantém a fila de processos prontos (ready_queue), ou seja,
- * processos que estão aptos a serem executados pela CPU.
- * Cada elemento da fila é um ponteiro para um BCP (Bloco de Controle de Processo).
+ * Decide quando eleger um processo; quem é eleito fica a cargo da classe de
+ * escalonamento (ver sched_class.h), que mantém a fila de processos prontos,
+ * ou seja, processos que estão aptos a serem executados pela CPU.
+ *
+ * Cada núcleo da CPU tem sua própria fila de prontos. Processos novos vão para o
+ * núcleo menos carregado, processos desbloqueados voltam ao núcleo em que estavam,
+ * e um núcleo cuja fila esvaziou rouba o próximo processo do núcleo com mais
+ * processos prontos.
  */
 typedef struct Scheduler_s
 {
-    List *ready_queue; // Fila de Bcp* no estado PROCESS_STATE_READY
-    pthread_mutex_t ready_queue_mutex; // Mutex para proteger a fila de prontos
+    const SchedClass *sched_class;     // Política de escalonamento
+    SchedRunQueue *run_queues;         // Uma fila de prontos por núcleo da CPU
+    int core_count;                    // Quantidade de núcleos (e de filas)
+    int ready_count;                   // Processos prontos, somando todas as filas
+    pthread_mutex_t ready_queue_mutex; // Mutex para proteger as filas de prontos (e o estado da classe)
+    long long context_switch_count;    // Quantidade de eleições realizadas (protegido por ready_queue_mutex)
+    long long steal_count;             // Processos roubados da fila de outro núcleo (protegido por ready_queue_mutex)
+    // Hash FNV-1a da sequência de eleições (instante virtual, PID eleito e, com mais de
+    // um núcleo, o núcleo), protegido por ready_queue_mutex.
+    // Duas execuções com o mesmo escalonamento produzem o mesmo valor.
+    unsigned long long schedule_digest;
+    long long context_switch_ns;       // Tempo real total gasto em trocas de contexto (atualizado atomicamente)
 } Scheduler;
 
 /*
@@ -26,24 +52,49 @@ typedef struct Scheduler_s
 Scheduler *Scheduler__create();
 
 /*
- * Analisa a fila de prontos e seleciona o próximo processo a ser executado,
- * de acordo com o critério do projeto (menor número de operações de E/S).
- * Em caso de empate, escolhe o processo com menor PID.
- * Retorna: ponteiro para o BCP do processo escolhido, ou NULL se a fila estiver vazia.
+ * Seleciona o próximo processo a ser executado no núcleo, segundo a classe de escalonamento
+ * (na padrão, 'io', o de menor número de operações de E/S, com desempate pelo menor PID).
+ * Se a fila do núcleo estiver vazia, o candidato é o próximo da fila do núcleo com mais
+ * processos prontos. Quem chama deve segurar ready_queue_mutex.
+ * - source_core: recebe o núcleo em cuja fila está o processo escolhido.
+ * Retorna: ponteiro para o BCP do processo escolhido, ou NULL se todas as filas estiverem vazias.
+ */
+Bcp *Scheduler__get_next_process_to_run(int core, int *source_core);
+
+/*
+ * Insere um processo na fila de prontos. Quem chama deve segurar ready_queue_mutex.
+ * - reason: como o processo chegou à fila (novo, desbloqueado ou vindo da CPU).
+ * Um processo novo vai para a fila do núcleo menos carregado; os demais, para a fila
+ * do núcleo em que executaram por último.
  */
-Bcp *Scheduler__get_next_process_to_run(void);
+void Scheduler__add_ready_process(Bcp *ready_process, SchedEnqueueReason reason);
 
 /*
- * Realiza a troca de contexto entre processos.
- * Remove o processo atualmente em execução (se necessário) e coloca-o de volta na fila de prontos.
+ * Avisa a classe de escalonamento de que o processo concluiu uma operação de E/S.
+ * Chamada antes de o processo voltar à fila de prontos, com ready_queue_mutex travado.
+ */
+void Scheduler__io_completed(Bcp *process);
+
+/*
+ * Realiza a troca de contexto em um núcleo da CPU.
+ * Remove o processo em execução no núcleo (se necessário) e coloca-o de volta na fila de prontos.
  * Seleciona o próximo processo a ser executado e atualiza o estado do sistema.
  * Também registra a troca no log do escalonador.
  */
-void Scheduler__perform_context_switch(void);
+void Scheduler__perform_context_switch(int core);
+
+/*
+ * Realiza uma troca de contexto em cada núcleo ocioso enquanto houver processos prontos,
+ * para que ele inicie um processo da sua fila ou roube um da fila de outro núcleo.
+ * Chamada depois de inserir processos nas filas, sem ready_queue_mutex travado.
+ */
+void Scheduler__wake_idle_cores(void);
 
 /*
  * Atualiza as estatísticas de operações de E/S (leitura ou escrita) de um processo.
- * Deve ser chamada sempre que um processo realiza uma operação de disco.
+ * Deve ser chamada sempre que um processo realiza uma operação de disco; se o processo
+ * estiver na fila de prontos, sua posição é atualizada. Não deve ser chamada com
+ * ready_queue_mutex travado.
  * Parâmetros:
  * - target_process_bcp: ponteiro para o BCP do processo que realizou a operação.
  * - was_read_operation: 1 se foi leitura, 0 se foi escrita.